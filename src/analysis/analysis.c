@@ -12,6 +12,7 @@
  */
 
 #include <assert.h>
+#include <stdint.h>
 
 #include "analysis.h"
 #include "interpreter.h"
@@ -334,6 +335,136 @@ static void bind_variables_from_node_and_children(node_t *node, parser_memory_t
     }
 }
 
+/**
+ * @brief Numbers the declarators of every scope in the order of their execution.
+ *
+ * Walks the whole tree in depth-first order, which is the order in which the
+ * declarations of a scope are executed, and gives every declarator the next free
+ * slot of its scope. Formal arguments come first in a function scope, because the
+ * argument list precedes the body. At run time the entities of a context are
+ * created in the same order, so a variable can be addressed by its slot.
+ *
+ * This pass must run after the synthetic declarations have been inserted.
+ *
+ * @param node Current AST node.
+ */
+static void assign_slots_to_declarators(node_t *node) {
+    if (is_declarator(node->vtbl->type) && node->scope != NULL) {
+        declarator_t *declarator = (declarator_t*)node;
+        declarator->slot = node->scope->slot_count++;
+    }
+    size_t count = get_node_child_count(node);
+    for (size_t index = 0; index < count; index++) {
+        assign_slots_to_declarators(get_node_child(node, index));
+    }
+}
+
+/**
+ * @brief Marks a scope and all scopes enclosing it as escaping.
+ *
+ * The environment of an escaping scope is an object whose prototype is the environment of
+ * the enclosing scope, so the enclosing scope must be an object as well.
+ *
+ * @param scope The scope.
+ */
+static void mark_scope_as_escaping(scope_t *scope) {
+    while (scope != NULL && !scope->escapes) {
+        scope->escapes = true;
+        scope = scope->parent;
+    }
+}
+
+/**
+ * @brief Checks whether a variable of an enclosing function is surely declared when a nested
+ *  function assigns it.
+ *
+ * Nested functions are bound after the whole enclosing scope, so a name can be bound to
+ * a declarator that follows the function, or to a synthetic one inserted before a later
+ * statement. If the function is called before that declaration is executed, the store can not
+ * find the slot and creates the variable by name in the environment of the function, as
+ * the assignment of an undeclared variable does, so that environment must be an object.
+ * Node ids follow the order of execution within a function; synthetic nodes have no id.
+ *
+ * @param node The assignment.
+ * @param declarator The declarator of the assigned variable.
+ * @return `true` if the variable is declared in the same function or before the nested
+ *  function containing the assignment is created.
+ */
+static bool is_declared_before_assignment(const node_t *node, const declarator_t *declarator) {
+    const node_t *function = NULL;
+    while (node->parent != NULL && node->scope != declarator->base.scope) {
+        if (node->vtbl->type == NODE_FUNCTION_OBJECT) {
+            function = node;
+        }
+        node = node->parent;
+    }
+    if (function == NULL) {
+        return true;
+    }
+    return declarator->base.id != 0 && declarator->base.id <= function->parent->id;
+}
+
+/**
+ * @brief Checks whether the target of an assignment is a mutable variable addressed by its slot.
+ *
+ * Other targets (built-in names, constants, unbound names, variables that may not be declared
+ * yet) are stored by name, which requires the environment to be an object.
+ *
+ * @param assignment The assignment.
+ * @return `true` if the target does not require a named environment.
+ */
+static bool is_mutable_slot(const node_t *assignment) {
+    const node_t *target = get_node_child(assignment, 0);
+    if (target->vtbl->type != NODE_VARIABLE) {
+        return true;
+    }
+    const declarator_t *declarator = ((const variable_t *)target)->declarator;
+    return declarator != NULL && declarator != get_builtin_declarator()
+        && declarator->base.scope != NULL
+        && declarator->base.vtbl->type != NODE_CONSTANT_DECLARATOR
+        && is_declared_before_assignment(assignment, declarator);
+}
+
+/**
+ * @brief Finds the scopes whose environments can escape.
+ *
+ * A scope escapes if a function is created in it (the function captures the environment
+ * as its closure), if it is a block whose value is used (the block evaluates to its
+ * environment), or if a variable is stored in it by name. Scopes with too many slots or
+ * nested too deeply to be addressed by `LLOAD` are treated as escaping too. All other scopes
+ * are executed with frames that keep variables in slots.
+ *
+ * @param node Current AST node.
+ * @param depth Nesting depth of the scope of the node.
+ */
+static void find_escaping_scopes(node_t *node, unsigned int depth) {
+    switch (node->vtbl->type) {
+        case NODE_FUNCTION_OBJECT:
+            mark_scope_as_escaping(node->scope->parent);
+            break;
+        case NODE_STATEMENT_LIST:
+            if (node->parent == NULL || node->parent->vtbl->type != NODE_STATEMENT_EXPRESSION) {
+                mark_scope_as_escaping(node->scope);
+            }
+            break;
+        case NODE_SIMPLE_ASSIGNMENT:
+            if (!is_mutable_slot(node)) {
+                mark_scope_as_escaping(node->scope);
+            }
+            break;
+        default:
+            break;
+    }
+    if (depth > UINT8_MAX || node->scope->slot_count > UINT16_MAX) {
+        mark_scope_as_escaping(node->scope);
+    }
+    size_t count = get_node_child_count(node);
+    for (size_t index = 0; index < count; index++) {
+        node_t *child = get_node_child(node, index);
+        find_escaping_scopes(child, child->scope != node->scope ? depth + 1 : depth);
+    }
+}
+
 /**
  * @brief Binds variables in queued functions and the root subtree.
  *
@@ -420,6 +551,17 @@ compilation_error_t *analyze(node_t *root_node, parser_memory_t *memory, options
     */
     interpret(root_node, memory);
 
+    /*
+        Now the set of declarations is final, so the declarators can be numbered.
+    */
+    assign_slots_to_declarators(root_node);
+
+    /*
+        The global scope is the context of the process, which is always an object.
+    */
+    mark_scope_as_escaping(root_node->scope);
+    find_escaping_scopes(root_node, 0);
+
     // ... further analysis ...
     return errors;
 }
@@ -19,6 +19,7 @@
 #include "parser/parser.h"
 #include "analysis/analysis.h"
 #include "codegen/linker.h"
+#include "codegen/peephole.h"
 #include "codegen/source_builder.h"
 #include "graph/node.h"
 #include "graph/visualization.h"
@@ -158,9 +159,13 @@ int go(options_t *opt) {
         code_builder_t *code_builder = create_code_builder();
         data_builder_t *data_builder = create_data_builder();
         generate_bytecode_from_node(root_node, code_builder, data_builder);
-        bool processed_all;
+        bool processed_any;
         do {
-            processed_all = true;
+            /*
+                Functions declared in branches dropped by constant folding are never
+                emitted, so stop as soon as a pass makes no progress.
+            */
+            processed_any = false;
             list_item_t *func_item = parsing_result.functions->head;
             while(func_item) {
                 list_item_t *next_item = func_item->next;
@@ -168,12 +173,12 @@ int go(options_t *opt) {
                 if (generate_deferred_bytecode_from_node(func_obj, code_builder,
                         data_builder)) {
                     remove_item_from_linked_list(parsing_result.functions, func_item);
-                } else {
-                    processed_all = false;
+                    processed_any = true;
                 }
                 func_item = next_item;
             }
-        } while(!processed_all);
+        } while(processed_any);
+        apply_peephole_optimization(code_builder);
         bytecode_t *bytecode = link_code_and_data(code_builder, data_builder);
         destroy_code_builder(code_builder);
         destroy_data_builder(data_builder);
@@ -199,7 +204,19 @@ int go(options_t *opt) {
             14. run the virtual machine
         */
         process_t *process = create_process();
+        if (opt->gc_threshold >= 0) {
+            process->gc_min_threshold = (size_t)opt->gc_threshold;
+        }
+        if (opt->time_slice > 0) {
+            process->time_slice = (uint32_t)opt->time_slice;
+        }
         ret_code = run(process, bytecode);
+        if (opt->print_gc_statistics) {
+            gc_statistics_t *stat = &process->gc_statistics;
+            fprintf_utf8(stderr, get_messages()->gc_statistics, stat->collections,
+                stat->cycle_collections, stat->freed_objects, stat->total_pause, stat->max_pause);
+            fprintf(stderr, "\n");
+        }
         destroy_process(process);
 
         /*
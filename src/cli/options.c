@@ -9,6 +9,8 @@
  */
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <memory.h>
 
@@ -46,6 +48,7 @@ static bool check_graph_file(const char *filename) {
 options_t *create_options() {
     options_t *opt = (options_t *)CALLOC(sizeof(options_t));
     opt->script_args = create_vector();
+    opt->gc_threshold = -1;
     return opt;
 }
 
@@ -98,6 +101,42 @@ options_t *parse_options(int argc, char **argv) {
                 continue;
             }
 
+            if (strcmp(arg, "--gc-threshold") == 0) {
+                if (index + 1 >= argc || argv[index + 1][0] == '-') {
+                    fprintf_utf8(stderr, get_messages()->missing_specification, arg);
+                    goto error;
+                }
+                char *end;
+                const char *value = argv[++index];
+                opt->gc_threshold = strtol(value, &end, 10);
+                if (*value == '\0' || *end != '\0' || opt->gc_threshold < 0) {
+                    fprintf_utf8(stderr, get_messages()->bad_gc_threshold);
+                    goto error;
+                }
+                continue;
+            }
+
+            if (strcmp(arg, "--time-slice") == 0) {
+                if (index + 1 >= argc || argv[index + 1][0] == '-') {
+                    fprintf_utf8(stderr, get_messages()->missing_specification, arg);
+                    goto error;
+                }
+                char *end;
+                const char *value = argv[++index];
+                opt->time_slice = strtol(value, &end, 10);
+                if (*value == '\0' || *end != '\0' || opt->time_slice <= 0
+                        || opt->time_slice > UINT32_MAX) {
+                    fprintf_utf8(stderr, get_messages()->bad_time_slice);
+                    goto error;
+                }
+                continue;
+            }
+
+            if (strcmp(arg, "--gc-stats") == 0) {
+                opt->print_gc_statistics = true;
+                continue;
+            }
+
             if (strcmp(arg, "-l") == 0 || strcmp(arg, "--lang") == 0
                     || strcmp(arg, "--language") == 0) {
                 if (index + 1 >= argc || argv[index + 1][0] == '-') {
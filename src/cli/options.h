@@ -77,6 +77,28 @@ struct options_t {
      */
     path_t *graph_output_file;
 
+    /**
+     * @brief The minimum number of live objects that starts garbage collection during
+     *  the execution, or -1 to use the default value.
+     * 
+     * Zero disables garbage collection during the execution.
+     */
+    long gc_threshold;
+
+    /**
+     * @brief Time slice (quantum) of the thread scheduler, in instructions, or zero to use
+     *  the default value.
+     */
+    long time_slice;
+
+    /**
+     * @brief Flag to enable printing of garbage collector statistics.
+     * 
+     * If set to `true`, the program will output the number of collections, the number of
+     * freed objects and the pause times to the standard error stream after the execution.
+     */
+    bool print_gc_statistics;
+
     /**
      * @brief Arguments to be passed to the script.
      * 
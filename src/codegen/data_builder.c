@@ -39,6 +39,39 @@ data_builder_t *create_data_builder(void) {
     return builder;
 }
 
+/**
+ * @struct string_relocation_t
+ * @brief Parameters for moving the keys of the string map to a new data array.
+ */
+typedef struct {
+    /**
+     * @brief The new string map.
+     */
+    avl_tree_t *strings;
+
+    /**
+     * @brief The old data array.
+     */
+    uint8_t *old_data;
+
+    /**
+     * @brief The new data array.
+     */
+    uint8_t *new_data;
+} string_relocation_t;
+
+/**
+ * @brief Adds a string to the new string map, pointing its key into the new data array.
+ * @param user_data The relocation parameters.
+ * @param key The key (a string in the old data array).
+ * @param value The index of the data descriptor.
+ */
+static void relocate_string(void *user_data, void *key, value_t value) {
+    string_relocation_t *relocation = (string_relocation_t *)user_data;
+    uint8_t *new_key = relocation->new_data + ((uint8_t *)key - relocation->old_data);
+    set_in_avl_tree(relocation->strings, new_key, value);
+}
+
 uint32_t add_data_to_data_segment(data_builder_t *builder, void *data, size_t size) {
     size_t aligned_size = (size + 3) & ~3;
     size_t new_size = builder->data_size + aligned_size;
@@ -48,8 +81,17 @@ uint32_t add_data_to_data_segment(data_builder_t *builder, void *data, size_t si
             new_capacity = new_size;
         }
         builder->data_capacity = new_capacity;
-        uint8_t *new_data = (uint8_t *)ALLOC(new_size);
+        uint8_t *new_data = (uint8_t *)ALLOC(new_capacity);
         memcpy(new_data, builder->data, builder->data_size);
+        // the keys of the string map point into the data array, so they are moved too
+        string_relocation_t relocation = {
+            .strings = create_avl_tree(string_comparator),
+            .old_data = builder->data,
+            .new_data = new_data
+        };
+        avl_tree_for_each(builder->strings, relocate_string, &relocation);
+        destroy_avl_tree(builder->strings);
+        builder->strings = relocation.strings;
         FREE(builder->data);
         builder->data = new_data;
     }
@@ -104,6 +146,14 @@ uint32_t add_string_to_data_segment_ex(data_builder_t *builder, string_view_t st
     return index;
 }
 
+uint32_t add_integer_to_data_segment(data_builder_t *builder, int64_t value) {
+    return add_data_to_data_segment(builder, &value, sizeof(value));
+}
+
+uint32_t add_real_to_data_segment(data_builder_t *builder, double value) {
+    return add_data_to_data_segment(builder, &value, sizeof(value));
+}
+
 void destroy_data_builder(data_builder_t *builder) {
     FREE(builder->descriptors);
     FREE(builder->data);
@@ -122,6 +122,30 @@ uint32_t add_string_to_data_segment(data_builder_t *builder, const wchar_t *stri
  */
 uint32_t add_string_to_data_segment_ex(data_builder_t *builder, string_view_t string);
 
+/**
+ * @brief Adds a 64-bit integer constant to the data segment.
+ * 
+ * The constant is stored as 8 bytes in the native byte order; the VM creates the integer
+ * object from it once per process (see the `ILOADK` opcode).
+ * 
+ * @param builder The data builder to which the constant will be added.
+ * @param value The value of the constant.
+ * @return The index of the added data descriptor.
+ */
+uint32_t add_integer_to_data_segment(data_builder_t *builder, int64_t value);
+
+/**
+ * @brief Adds a real number constant to the data segment.
+ * 
+ * The constant is stored as 8 bytes in the native byte order; the VM creates the real number
+ * object from it once per process (see the `RLOADK` opcode).
+ * 
+ * @param builder The data builder to which the constant will be added.
+ * @param value The value of the constant.
+ * @return The index of the added data descriptor.
+ */
+uint32_t add_real_to_data_segment(data_builder_t *builder, double value);
+
 /**
  * @brief Destroys the data builder and frees its memory.
  *
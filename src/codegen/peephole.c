@@ -0,0 +1,138 @@
+/**
+ * @file peephole.c
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Implementation of the peephole optimization of generated bytecode.
+ *
+ * The set of fused sequences comes from instruction pair counts of the test programs:
+ * loading a small integer constant right before an arithmetic operation or a comparison
+ * (`n - 1`, `n < 2`) dominates recursive code, while statements like `x = ...;` and `var x;`
+ * produce `LSTORE; POP` and `NIL; VAR`.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "peephole.h"
+#include "lib/allocate.h"
+
+/**
+ * @def REFERENCE
+ * @brief Produces an entry of the reference table.
+ */
+#define REFERENCE(name, reference) reference,
+
+/**
+ * @brief The kind of reference to other instructions of every opcode, indexed by opcode.
+ */
+static const instruction_reference_t references[] = { FOR_EACH_OPCODE(REFERENCE) };
+
+#undef REFERENCE
+
+/**
+ * @brief Checks whether an instruction stores an index of another instruction in `arg1`.
+ * @param instructions The instruction list.
+ * @param index The index of the instruction to check.
+ * @param size The number of instructions.
+ * @return `true` for opcodes whose `arg1` is an instruction index and for an `ARG` that passes
+ *  the entry point to the following instruction.
+ */
+static bool refers_to_instruction(const instruction_t *instructions, size_t index, size_t size) {
+    if (instructions[index].opcode == ARG) {
+        return index + 1 < size
+            && references[instructions[index + 1].opcode] == ENTRY_POINT_IN_ARG;
+    }
+    return references[instructions[index].opcode] == INSTRUCTION_INDEX;
+}
+
+/**
+ * @brief Tries to fuse two consecutive instructions into a superinstruction.
+ * @param first The first instruction.
+ * @param second The second instruction.
+ * @param fused Where to store the superinstruction.
+ * @return `true` if the instructions have been fused.
+ */
+static bool fuse_instructions(instruction_t first, instruction_t second, instruction_t *fused) {
+    switch (first.opcode) {
+        case ILOAD32:
+            switch (second.opcode) {
+                case ADD:
+                case IADD:
+                    *fused = (instruction_t){ .opcode = ADDI, .flags = second.flags,
+                        .arg1 = first.arg1 };
+                    return true;
+                case SUB:
+                case ISUB:
+                    *fused = (instruction_t){ .opcode = SUBI, .flags = second.flags,
+                        .arg1 = first.arg1 };
+                    return true;
+                case JNLT:
+                case IJNLT: {
+                    int32_t value = (int32_t)first.arg1;
+                    if (value < INT16_MIN || value > INT16_MAX) {
+                        return false;
+                    }
+                    *fused = (instruction_t){ .opcode = JNLTI, .arg0 = (uint16_t)(int16_t)value,
+                        .arg1 = second.arg1 };
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        case NIL:
+            if (second.opcode == VAR) {
+                *fused = (instruction_t){ .opcode = VARNIL, .arg0 = second.arg0,
+                    .arg1 = second.arg1 };
+                return true;
+            }
+            return false;
+        case LSTORE:
+            if (second.opcode == POP) {
+                *fused = first;
+                fused->opcode = LSTOREP;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+void apply_peephole_optimization(code_builder_t *builder) {
+    size_t size = builder->size;
+    instruction_t *instructions = builder->instructions;
+    bool *is_target = (bool *)CALLOC((size + 1) * sizeof(bool));
+    for (size_t index = 0; index < size; index++) {
+        if (refers_to_instruction(instructions, index, size) && instructions[index].arg1 <= size) {
+            is_target[instructions[index].arg1] = true;
+        }
+    }
+
+    /*
+        Compact the list in place: the write position never overtakes the read position.
+    */
+    size_t *new_index = (size_t *)ALLOC((size + 1) * sizeof(size_t));
+    size_t count = 0;
+    size_t index = 0;
+    while (index < size) {
+        instruction_t fused;
+        new_index[index] = count;
+        if (index + 1 < size && !is_target[index + 1]
+                && fuse_instructions(instructions[index], instructions[index + 1], &fused)) {
+            new_index[index + 1] = count;
+            instructions[count++] = fused;
+            index += 2;
+        } else {
+            instructions[count++] = instructions[index++];
+        }
+    }
+    new_index[size] = count;
+
+    for (index = 0; index < count; index++) {
+        if (refers_to_instruction(instructions, index, count) && instructions[index].arg1 <= size) {
+            instructions[index].arg1 = (uint32_t)new_index[instructions[index].arg1];
+        }
+    }
+    builder->size = count;
+    FREE(new_index);
+    FREE(is_target);
+}
@@ -0,0 +1,24 @@
+/**
+ * @file peephole.h
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Peephole optimization of generated bytecode.
+ *
+ * After the whole program has been compiled, the instruction list is scanned for short fixed
+ * sequences that are replaced by superinstructions, which do the same work with a single
+ * dispatch. Jump targets and function entry points are then renumbered.
+ */
+
+#pragma once
+
+#include "code_builder.h"
+
+/**
+ * @brief Replaces common instruction sequences with superinstructions.
+ *
+ * Two instructions are never fused if the second one is a jump target or a function entry
+ * point. All instruction indexes stored in instructions (jump targets, function entry points
+ * passed through `ARG`) are updated to the new positions.
+ *
+ * @param builder The code builder containing the complete program.
+ */
+void apply_peephole_optimization(code_builder_t *builder);
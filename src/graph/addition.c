@@ -130,11 +130,12 @@ static const lattice_element_t *add_string_constants(arena_t *arena,
         return left;
     }
     size_t length = left_string->value.length + right_string->value.length;
-    wchar_t *data = (wchar_t*)alloc_from_arena(arena, sizeof(wchar_t) * length);
+    wchar_t *data = (wchar_t*)alloc_from_arena(arena, sizeof(wchar_t) * (length + 1));
     wmemcpy(data, left_string->value.data, left_string->value.length);
     wmemcpy(data + left_string->value.length,
             right_string->value.data,
             right_string->value.length);
+    data[length] = L'\0';
     return make_string_constant_element(
         arena,
         (string_view_t){
@@ -409,9 +410,10 @@ static const lattice_element_t *calculate_array_addition(
  */
 static const lattice_element_t *calculate(node_t *node,
         abstract_state_t *state, arena_t *arena) {
-    const binary_operation_t *expr = (const binary_operation_t *)node;
+    binary_operation_t *expr = (binary_operation_t *)node;
     const lattice_element_t *left = calculate_expression(expr->left_operand, state, arena);
     const lattice_element_t *right = calculate_expression(expr->right_operand, state, arena);
+    binop_record_operand_values(expr, arena, left, right);
 
     switch (left->type) {
         case LATTICE_BOTTOM:
@@ -522,11 +524,22 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
     generate_indented_goat_code_from_expression(expr->base.right_operand, builder, indent);
 }
 
+/**
+ * @brief Adds two integers.
+ * @param first The first integer.
+ * @param second The second integer.
+ * @return The sum.
+ */
+static int64_t add_integers(int64_t first, int64_t second) {
+    return first + second;
+}
+
 /**
  * @brief Generates bytecode for an addition operation node.
  * 
  * This function generates bytecode for an addition operation by first generating the bytecode
- * for the left and right operands, and then generating the `ADD` instruction for the addition.
+ * for the left and right operands, and then generating the `ADD` instruction for the addition,
+ * or `IADD` / `RADD` if the analysis has proven that the operands are numbers.
  * 
  * @param node A pointer to the node representing the addition operation.
  * @param code A pointer to the `code_builder_t` structure used for generating instructions.
@@ -539,7 +552,7 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
     instr_index_t first = generate_bytecode_from_expression(
         expr->base.left_operand, code, data);
     generate_bytecode_from_expression(expr->base.right_operand, code, data);
-    add_instruction(code, (instruction_t){ .opcode = ADD });
+    binop_add_instruction(&expr->base, code, ADD, IADD, RADD, add_integers);
     return first;
 }
 
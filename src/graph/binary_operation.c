@@ -6,7 +6,9 @@
  * This file contains the implementation of virtual methods specific to binary operation nodes.
  */
 
- #include "binary_operation.h"
+#include "binary_operation.h"
+#include "analysis/lattice.h"
+#include "codegen/code_builder.h"
 
 size_t binop_get_child_count(const node_t *node) {
     return 2;
@@ -32,3 +34,132 @@ const wchar_t* binop_get_tag(const node_t *node, size_t index) {
     }
     return NULL;
 }
+
+void binop_record_operand_values(binary_operation_t *expr, arena_t *arena,
+        const lattice_element_t *left, const lattice_element_t *right) {
+    expr->left_value = expr->left_value ? lattice_join(arena, expr->left_value, left) : left;
+    expr->right_value = expr->right_value ? lattice_join(arena, expr->right_value, right) : right;
+}
+
+bool binop_get_numeric_constant(const lattice_element_t *element, double *value) {
+    if (element->type == LATTICE_INTEGER_CONSTANT) {
+        *value = (double)((const integer_constant_element_t *)element)->value;
+        return true;
+    }
+    if (element->type == LATTICE_REAL_CONSTANT) {
+        *value = ((const real_constant_element_t *)element)->value;
+        return true;
+    }
+    return false;
+}
+
+const lattice_element_t *binop_calculate_arithmetic(arena_t *arena,
+        const lattice_element_t *left, const lattice_element_t *right,
+        bool (*integer)(int64_t, int64_t, int64_t *), double (*real)(double, double)) {
+    if (left->type == LATTICE_BOTTOM || right->type == LATTICE_BOTTOM) {
+        return make_bottom_element();
+    }
+    if (left->type == LATTICE_INTEGER_CONSTANT && right->type == LATTICE_INTEGER_CONSTANT) {
+        int64_t result;
+        if (integer(((const integer_constant_element_t *)left)->value,
+                ((const integer_constant_element_t *)right)->value, &result)) {
+            return make_integer_constant_element(arena, result);
+        }
+        return make_integer_element();
+    }
+    double left_real, right_real;
+    if (binop_get_numeric_constant(left, &left_real)
+            && binop_get_numeric_constant(right, &right_real)) {
+        return make_real_constant_element(arena, real(left_real, right_real));
+    }
+    if (is_integer_lattice_element(left) && is_integer_lattice_element(right)) {
+        return make_integer_element();
+    }
+    if (is_real_lattice_element(left) && is_numeric_lattice_element(right)) {
+        return make_real_element();
+    }
+    if (is_numeric_lattice_element(left) && is_numeric_lattice_element(right)) {
+        return make_numeric_element();
+    }
+    return make_top_element();
+}
+
+operand_domain_t binop_get_operand_domain(const binary_operation_t *expr) {
+    const lattice_element_t *left = expr->left_value;
+    const lattice_element_t *right = expr->right_value;
+    if (is_integer_lattice_element(left) && is_integer_lattice_element(right)) {
+        return OPERANDS_INTEGER;
+    }
+    if (is_real_lattice_element(left)
+            && (is_real_lattice_element(right) || is_integer_lattice_element(right))) {
+        return OPERANDS_REAL;
+    }
+    return OPERANDS_UNKNOWN;
+}
+
+/**
+ * @brief Gets the bounds of an integer lattice element, if they are small enough.
+ * @param element The lattice element.
+ * @param min Where to store the lower bound.
+ * @param max Where to store the upper bound.
+ * @return `true` if the element is an integer constant or range within
+ *  [`-SMALL_INTEGER_LIMIT`, `SMALL_INTEGER_LIMIT`].
+ */
+static bool get_small_integer_bounds(const lattice_element_t *element, int64_t *min,
+        int64_t *max) {
+    if (element->type == LATTICE_INTEGER_CONSTANT) {
+        *min = *max = ((const integer_constant_element_t *)element)->value;
+    } else if (element->type == LATTICE_INTEGER_RANGE) {
+        *min = ((const integer_range_element_t *)element)->min;
+        *max = ((const integer_range_element_t *)element)->max;
+    } else {
+        return false;
+    }
+    return *min >= -SMALL_INTEGER_LIMIT && *max <= SMALL_INTEGER_LIMIT;
+}
+
+/**
+ * @brief Checks whether the result of an operation on two integers is small.
+ * 
+ * Addition, subtraction and multiplication reach their extremes at the corners of
+ * the operand ranges, so it is enough to check the four corners. The operands are small,
+ * so none of the corners overflows.
+ * 
+ * @param expr The binary operation with integer operands.
+ * @param operation The operation.
+ * @return `true` if the result is proven to be within [`-SMALL_INTEGER_LIMIT`,
+ *  `SMALL_INTEGER_LIMIT`].
+ */
+static bool is_result_small(const binary_operation_t *expr,
+        int64_t (*operation)(int64_t, int64_t)) {
+    int64_t left[2], right[2];
+    if (!get_small_integer_bounds(expr->left_value, &left[0], &left[1])
+            || !get_small_integer_bounds(expr->right_value, &right[0], &right[1])) {
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            int64_t result = operation(left[i], right[j]);
+            if (result < -SMALL_INTEGER_LIMIT || result > SMALL_INTEGER_LIMIT) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+instr_index_t binop_add_instruction(const binary_operation_t *expr, code_builder_t *code,
+        opcode_t generic, opcode_t integer, opcode_t real,
+        int64_t (*operation)(int64_t, int64_t)) {
+    switch (binop_get_operand_domain(expr)) {
+        case OPERANDS_INTEGER:
+            return add_instruction(code, (instruction_t){
+                .opcode = integer,
+                .flags = operation && is_result_small(expr, operation) ? INTEGER_RESULT_FITS : 0
+            });
+        case OPERANDS_REAL:
+            return add_instruction(code, (instruction_t){ .opcode = real });
+        default:
+            return add_instruction(code, (instruction_t){ .opcode = generic });
+    }
+}
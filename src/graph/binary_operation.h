@@ -10,7 +10,10 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include "expression.h"
+#include "vm/opcodes.h"
 
 /**
  * @typedef binary_operation_t
@@ -40,8 +43,42 @@ struct binary_operation_t {
      * @brief Pointer to the right operand expression.
      */
     expression_t *right_operand;
+
+    /**
+     * @brief Join of all abstract values of the left operand observed by the abstract
+     *  interpretation, or `NULL` if the operation has never been analyzed.
+     */
+    const lattice_element_t *left_value;
+
+    /**
+     * @brief Join of all abstract values of the right operand observed by the abstract
+     *  interpretation, or `NULL` if the operation has never been analyzed.
+     */
+    const lattice_element_t *right_value;
 };
 
+/**
+ * @enum operand_domain_t
+ * @brief What the abstract interpretation has proven about the operands of a binary operation.
+ */
+typedef enum {
+    /**
+     * @brief Nothing useful is known, the generic instruction must be emitted.
+     */
+    OPERANDS_UNKNOWN,
+
+    /**
+     * @brief Both operands are integers.
+     */
+    OPERANDS_INTEGER,
+
+    /**
+     * @brief The left operand is a real number, the right one is a real number or an integer,
+     *  so the operation is performed on `double` values.
+     */
+    OPERANDS_REAL
+} operand_domain_t;
+
 /**
  * @brief Gets the number of child nodes for binary operation.
  * 
@@ -84,6 +121,73 @@ node_t* binop_get_child(const node_t *node, size_t index);
  */
 const wchar_t* binop_get_tag(const node_t *node, size_t index);
 
+/**
+ * @brief Records the abstract values of the operands of a binary operation.
+ * 
+ * Called by the `calculate` methods of binary operations. A node can be calculated several
+ * times, so the values are joined with the ones recorded before.
+ * 
+ * @param expr The binary operation.
+ * @param arena Memory arena for allocating lattice elements.
+ * @param left The abstract value of the left operand.
+ * @param right The abstract value of the right operand.
+ */
+void binop_record_operand_values(binary_operation_t *expr, arena_t *arena,
+        const lattice_element_t *left, const lattice_element_t *right);
+
+/**
+ * @brief Gets the value of a numeric constant lattice element as a real number.
+ * @param element The lattice element.
+ * @param value Where to store the value.
+ * @return `true` if the element is an integer or a real constant.
+ */
+bool binop_get_numeric_constant(const lattice_element_t *element, double *value);
+
+/**
+ * @brief Calculates the abstract result of an arithmetic operation (`-`, `*`).
+ * 
+ * Two numeric constants give a constant, computed the same way as at run time: two integers
+ * with the integer operation (unless it overflows), otherwise with the real operation.
+ * For other operands only the type of the result is inferred: integer for two integers, real
+ * if the left operand is real, and so on. Unknown operands give an unknown result.
+ * 
+ * @param arena Memory arena for allocating lattice elements.
+ * @param left The abstract value of the left operand.
+ * @param right The abstract value of the right operand.
+ * @param integer The operation on integers; returns `false` on overflow.
+ * @param real The operation on real numbers.
+ * @return The abstract value of the result.
+ */
+const lattice_element_t *binop_calculate_arithmetic(arena_t *arena,
+        const lattice_element_t *left, const lattice_element_t *right,
+        bool (*integer)(int64_t, int64_t, int64_t *), double (*real)(double, double));
+
+/**
+ * @brief Determines which kind of numbers the operands of a binary operation are.
+ * @param expr The binary operation.
+ * @return The domain of the operands according to the recorded abstract values.
+ */
+operand_domain_t binop_get_operand_domain(const binary_operation_t *expr);
+
+/**
+ * @brief Emits the instruction of a binary operation, choosing it by the domain of the operands.
+ * 
+ * The operands must already be emitted. For integer operands, if `operation` is given and
+ * the ranges of the operands prove that the result of `operation` does not exceed
+ * `SMALL_INTEGER_LIMIT`, the instruction gets the `INTEGER_RESULT_FITS` flag.
+ * 
+ * @param expr The binary operation.
+ * @param code The code builder.
+ * @param generic The generic opcode (`ADD`, `LESS`, ...).
+ * @param integer The opcode for integer operands.
+ * @param real The opcode for real operands.
+ * @param operation The operation on integers, or `NULL` if the result is not an integer.
+ * @return The index of the emitted instruction.
+ */
+instr_index_t binop_add_instruction(const binary_operation_t *expr, code_builder_t *code,
+        opcode_t generic, opcode_t integer, opcode_t real,
+        int64_t (*operation)(int64_t, int64_t));
+
 /**
  * @brief Creates a new addition operation node.
  * 
@@ -0,0 +1,157 @@
+/**
+ * @file constant_folding.c
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Folding of expressions whose values are known at compile time.
+ *
+ * The abstract interpretation records the value of every expression it visits. If an expression
+ * is built only from literals, constants and operations on them, and its recorded value is
+ * a single constant, the code generator emits one load instruction instead of computing it.
+ *
+ * The analysis does not follow every path (function bodies and branches are skipped), so
+ * the facts about variables may be incomplete. That is why only expressions that can not be
+ * affected by other code are folded.
+ */
+
+#include "expression.h"
+#include "declarations.h"
+#include "variable.h"
+#include "analysis/lattice.h"
+#include "codegen/code_builder.h"
+#include "codegen/data_builder.h"
+
+/**
+ * @def MAX_FOLDING_DEPTH
+ * @brief Maximum depth of constants referring to other constants that is followed while
+ *  checking an expression; also stops on (invalid) circular definitions.
+ */
+#define MAX_FOLDING_DEPTH 64
+
+/**
+ * @brief Checks whether a lattice element describes exactly one value that can be loaded
+ *  by a single instruction.
+ * @param element The lattice element.
+ * @return `true` if the element is a constant.
+ */
+static bool is_constant_lattice_element(const lattice_element_t *element) {
+    if (!element) {
+        return false;
+    }
+    switch (element->type) {
+        case LATTICE_NULL:
+        case LATTICE_INTEGER_CONSTANT:
+        case LATTICE_REAL_CONSTANT:
+        case LATTICE_STRING_CONSTANT:
+        case LATTICE_TRUE:
+        case LATTICE_FALSE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Checks whether the value of an expression can not be changed by other code.
+ *
+ * Literals are stable; so are constants whose initializers are stable and which were read
+ * after their declaration (the value seen by the reading node matches the initializer).
+ * Calls, assignments and functions are never stable; any other expression is stable if all
+ * its children are.
+ *
+ * @param node The expression node.
+ * @param depth Number of constants followed so far.
+ * @return `true` if the expression is stable.
+ */
+static bool is_stable_expression(const node_t *node, unsigned int depth) {
+    switch (node->vtbl->type) {
+        case NODE_VARIABLE: {
+            const variable_t *var = (const variable_t *)node;
+            const declarator_t *declarator = var->declarator;
+            if (depth >= MAX_FOLDING_DEPTH || declarator == NULL
+                    || declarator == get_builtin_declarator()
+                    || declarator->base.vtbl->type != NODE_CONSTANT_DECLARATOR) {
+                return false;
+            }
+            const expression_t *initial =
+                (const expression_t *)get_node_child(&declarator->base, 0);
+            const lattice_element_t *value = var->base.base.value;
+            return is_constant_lattice_element(value) && is_constant_lattice_element(initial->value)
+                && value->type == initial->value->type
+                && is_stable_expression(&initial->base, depth + 1);
+        }
+        case NODE_FUNCTION_OBJECT:
+        case NODE_FUNCTION_CALL:
+        case NODE_SIMPLE_ASSIGNMENT:
+        case NODE_STATEMENT_LIST:
+            return false;
+        default: {
+            size_t count = get_node_child_count(node);
+            for (size_t index = 0; index < count; index++) {
+                if (!is_stable_expression(get_node_child(node, index), depth)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+}
+
+const lattice_element_t *get_constant_expression_value(const expression_t *expr) {
+    if (!is_constant_lattice_element(expr->value) || !is_stable_expression(&expr->base, 0)) {
+        return NULL;
+    }
+    return expr->value;
+}
+
+instr_index_t generate_bytecode_for_integer(int64_t value, code_builder_t *code,
+        data_builder_t *data) {
+    if (value >= -SMALL_INTEGER_LIMIT && value <= SMALL_INTEGER_LIMIT) {
+        return add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = value });
+    }
+    uint32_t index = add_integer_to_data_segment(data, value);
+    return add_instruction(code, (instruction_t){ .opcode = ILOADK, .arg1 = index });
+}
+
+instr_index_t generate_bytecode_for_real(double value, code_builder_t *code,
+        data_builder_t *data) {
+    uint32_t index = add_real_to_data_segment(data, value);
+    return add_instruction(code, (instruction_t){ .opcode = RLOADK, .arg1 = index });
+}
+
+/**
+ * @brief Emits the instructions that load a constant onto the data stack.
+ * @param value The constant lattice element.
+ * @param code A pointer to the code builder.
+ * @param data A pointer to the data builder.
+ * @return The instruction index of the first emitted instruction.
+ */
+static instr_index_t generate_bytecode_for_constant(const lattice_element_t *value,
+        code_builder_t *code, data_builder_t *data) {
+    switch (value->type) {
+        case LATTICE_INTEGER_CONSTANT:
+            return generate_bytecode_for_integer(
+                ((const integer_constant_element_t *)value)->value, code, data);
+        case LATTICE_REAL_CONSTANT:
+            return generate_bytecode_for_real(
+                ((const real_constant_element_t *)value)->value, code, data);
+        case LATTICE_STRING_CONSTANT: {
+            uint32_t index = add_string_to_data_segment_ex(data,
+                ((const string_constant_element_t *)value)->value);
+            return add_instruction(code, (instruction_t){ .opcode = SLOAD, .arg1 = index });
+        }
+        case LATTICE_TRUE:
+            return add_instruction(code, (instruction_t){ .opcode = TRUE });
+        case LATTICE_FALSE:
+            return add_instruction(code, (instruction_t){ .opcode = FALSE });
+        default:
+            return add_instruction(code, (instruction_t){ .opcode = NIL });
+    }
+}
+
+instr_index_t generate_bytecode_from_expression(expression_t *expr,
+        code_builder_t *code, data_builder_t *data) {
+    const lattice_element_t *value = get_constant_expression_value(expr);
+    if (value) {
+        return generate_bytecode_for_constant(value, code, data);
+    }
+    return generate_bytecode_from_node(&expr->base, code, data);
+}
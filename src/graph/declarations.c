@@ -211,7 +211,7 @@ static void vdeclr_generate_indented_goat_code(const node_t *node, source_builde
  * Produces bytecode that:
  * 1. Evaluates initializer (or pushes NIL if none)
  * 2. Pops the value (handled by declaration statement)
- * 3. Declares the variable in current scope
+ * 3. Declares the variable in current scope (in its slot, if the scope is a frame)
  * 
  * @param node Pointer to the variable declarator node.
  * @param code Pointer to the code builder for bytecode generation.
@@ -228,7 +228,8 @@ static instr_index_t vdeclr_generate_bytecode(node_t *node, code_builder_t *code
         first = add_instruction(code, (instruction_t){ .opcode = NIL });
     }
     uint32_t index = add_string_to_data_segment_ex(data, decl->base.name);
-    add_instruction(code, (instruction_t){ .opcode = VAR, .arg1 = index });
+    add_instruction(code, (instruction_t){ .opcode = VAR, .arg0 = (uint16_t)decl->base.slot,
+        .arg1 = index });
     return first;
 }
 
@@ -626,7 +627,7 @@ static void cdeclr_generate_indented_goat_code(const node_t *node, source_builde
  * Produces bytecode that:
  * 1. Evaluates the initializer expression
  * 2. Pops the value from stack (handled by declaration statement)
- * 3. Declares the constant in current scope
+ * 3. Declares the constant in current scope (in its slot, if the scope is a frame)
  * 
  * @param node Pointer to the constant declarator node.
  * @param code Pointer to the code builder for bytecode output.
@@ -638,7 +639,8 @@ static instr_index_t cdeclr_generate_bytecode(node_t *node, code_builder_t *code
     const constant_declarator_t* decl = (const constant_declarator_t*)node;
     instr_index_t first = generate_bytecode_from_expression(decl->initial, code, data);
     uint32_t index = add_string_to_data_segment_ex(data, decl->base.name);
-    add_instruction(code, (instruction_t){ .opcode = CONST, .arg1 = index });
+    add_instruction(code, (instruction_t){ .opcode = CONST, .arg0 = (uint16_t)decl->base.slot,
+        .arg1 = index });
     return first;
 }
 
@@ -112,6 +112,17 @@ typedef struct declarator_t {
      * them.
      */
     const lattice_element_t *abstract_value;
+
+    /**
+     * @brief Index of the declared entity among the entities of its scope.
+     *
+     * At run time every scope is a context, and the entities of the context are
+     * created in the order in which their declarations are executed. The static
+     * analysis numbers the declarators of each scope in the same order, so the
+     * code generator can address a variable by (scope depth, slot) instead of
+     * searching for it by name.
+     */
+    unsigned int slot;
 } declarator_t;
 
 /**
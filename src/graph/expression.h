@@ -11,6 +11,7 @@
 
 #include "node.h"
 #include "data_type.h"
+#include "analysis/lattice.h"
 
 /**
  * @brief Forward declaration of declarator structure (needed for variable & constant declaration).
@@ -35,6 +36,12 @@ struct expression_t {
      * when the type is inferred/unknown at the current stage.
      */
     const data_type_t *data_type;
+
+    /**
+     * @brief Join of all abstract values of the expression observed by the abstract
+     *  interpretation, or `NULL` if the expression has never been analyzed.
+     */
+    const lattice_element_t *value;
 };
 
 /**
@@ -91,7 +98,8 @@ static inline const wchar_t *get_expression_child_tag(const expression_t *expr,
 /**
  * @brief Calculates the abstract lattice element represented by an expression.
  *
- * This helper forwards the request to the underlying base node helper.
+ * This helper forwards the request to the underlying base node helper and joins
+ * the result into the value recorded in the expression.
  *
  * @param expr A pointer to the expression.
  * @param arena Memory arena for allocating lattice elements.
@@ -99,9 +107,24 @@ static inline const wchar_t *get_expression_child_tag(const expression_t *expr,
  */
 static inline const lattice_element_t *calculate_expression(expression_t *expr,
         abstract_state_t *state, arena_t *arena) {
-    return calculate_node(&expr->base, state, arena);
+    const lattice_element_t *value = calculate_node(&expr->base, state, arena);
+    expr->value = expr->value ? lattice_join(arena, expr->value, value) : value;
+    return value;
 }
 
+/**
+ * @brief Gets the value of an expression if it is known at compile time.
+ *
+ * The value is known if the expression consists only of literals, constants and operations
+ * on them, and the abstract interpretation proved it to be a single constant (a number,
+ * a string, a boolean or `null`). Variables are never trusted, since they can be changed
+ * by code the analysis does not follow, such as function bodies.
+ *
+ * @param expr A pointer to the expression.
+ * @return The constant lattice element, or `NULL` if the value is not known.
+ */
+const lattice_element_t *get_constant_expression_value(const expression_t *expr);
+
 /**
  * @brief Generates a single-line Goat source code representation from an expression.
  *
@@ -170,17 +193,45 @@ static inline void generate_indented_c_code_from_expression(const expression_t *
 /**
  * @brief Generates bytecode from an expression.
  *
- * This helper forwards the request to the underlying base node helper.
+ * An expression whose value is known at compile time (see
+ * @ref get_constant_expression_value) is folded into a single load instruction; otherwise,
+ * the request is forwarded to the underlying base node helper.
  *
  * @param expr A pointer to the expression.
  * @param code A pointer to the code builder used for instruction emission.
  * @param data A pointer to the data builder used for static data management.
  * @return The instruction index of the first emitted instruction.
  */
-static inline instr_index_t generate_bytecode_from_expression(expression_t *expr,
-        code_builder_t *code, data_builder_t *data) {
-    return generate_bytecode_from_node(&expr->base, code, data);
-}
+instr_index_t generate_bytecode_from_expression(expression_t *expr,
+        code_builder_t *code, data_builder_t *data);
+
+/**
+ * @brief Generates bytecode that loads an integer constant.
+ *
+ * Values that fit into a tagged integer are loaded with `ILOAD32`; larger ones are placed
+ * into the data segment and loaded with `ILOADK`, so the VM creates their objects only once.
+ *
+ * @param value The value of the constant.
+ * @param code A pointer to the code builder.
+ * @param data A pointer to the data builder.
+ * @return The instruction index of the emitted instruction.
+ */
+instr_index_t generate_bytecode_for_integer(int64_t value, code_builder_t *code,
+        data_builder_t *data);
+
+/**
+ * @brief Generates bytecode that loads a real number constant.
+ *
+ * The value is placed into the data segment and loaded with `RLOADK`, so the VM creates
+ * its object only once.
+ *
+ * @param value The value of the constant.
+ * @param code A pointer to the code builder.
+ * @param data A pointer to the data builder.
+ * @return The instruction index of the emitted instruction.
+ */
+instr_index_t generate_bytecode_for_real(double value, code_builder_t *code,
+        data_builder_t *data);
 
 /**
  * @brief Generates bytecode for storing a value into an expression.
@@ -350,6 +401,15 @@ node_t *create_function_object_node(arena_t *arena, string_view_t *arg_list, siz
  */
 void fill_function_body(node_t *node, list_t *statements);
 
+/**
+ * @brief Returns the index of the `FUNC` instruction that creates a function object.
+ * 
+ * @param node A pointer to a node of function object type.
+ * @return The index of the instruction, or `BAD_INSTR_INDEX` if the bytecode for the function
+ *  object has not been generated yet.
+ */
+instr_index_t get_function_creation_instruction(const node_t *node);
+
 /**
  * @brief Creates a new parenthesized expression node with no inner expression.
  *
@@ -10,9 +10,11 @@
  */
 
 #include <assert.h>
+#include <wchar.h>
 
 #include "expression.h"
 #include "common_methods.h"
+#include "variable.h"
 #include "lib/allocate.h"
 #include "lib/arena.h"
 #include "lib/string_ext.h"
@@ -121,10 +123,23 @@ static const wchar_t* get_child_tag(const node_t *node, size_t index) {
 }
 
 /**
- * ....
+ * @brief Calculates the abstract value of a function call expression.
+ *
+ * The function object and the arguments are calculated in evaluation order, so that
+ * the nodes inside them record what is known about their operands. Nothing is known
+ * about the called function, so the result is unknown.
+ *
+ * @param node A pointer to the function call expression node.
+ * @param state Current abstract state.
+ * @param arena Memory arena used for allocating lattice elements.
+ * @return Top element.
  */
 static const lattice_element_t *calculate(node_t *node, abstract_state_t *state, arena_t *arena) {
     const function_call_t* expr = (const function_call_t*)node;
+    calculate_expression(expr->func_object, state, arena);
+    for (size_t index = 0; index < expr->args_count; index++) {
+        calculate_expression(expr->args[index], state, arena);
+    }
     return make_top_element();
 }
 
@@ -191,13 +206,102 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
     append_static_source(builder, L")");
 }
 
+/**
+ * @struct intrinsic_t
+ * @brief A built-in function whose calls are compiled into a dedicated instruction.
+ */
+typedef struct {
+    /**
+     * @brief The name of the built-in function.
+     */
+    const wchar_t *name;
+
+    /**
+     * @brief The number of arguments the instruction takes from the stack.
+     */
+    size_t arg_count;
+
+    /**
+     * @brief The instruction replacing the call.
+     */
+    opcode_t opcode;
+} intrinsic_t;
+
+/**
+ * @var intrinsics
+ * @brief Built-in functions that have intrinsic instructions.
+ */
+static const intrinsic_t intrinsics[] = {
+    { L"atan", 2, ATAN2 },
+    { L"print", 1, PRINT },
+    { L"sign", 1, SIGN },
+    { L"sqrt", 1, SQRT }
+};
+
+/**
+ * @brief Finds the intrinsic instruction for a function call.
+ * 
+ * A call is replaced with an intrinsic if the called object is a variable that refers to
+ * a built-in function (the name is not shadowed by any declaration) having an intrinsic,
+ * and the call passes exactly the arguments the intrinsic takes.
+ * 
+ * @param expr The function call expression.
+ * @return The intrinsic, or `NULL` if the call must be performed as usual.
+ */
+static const intrinsic_t *find_intrinsic(const function_call_t *expr) {
+    if (expr->func_object->base.vtbl->type != NODE_VARIABLE) {
+        return NULL;
+    }
+    const variable_t *var = (const variable_t *)expr->func_object;
+    if (var->declarator != get_builtin_declarator()) {
+        return NULL;
+    }
+    for (size_t index = 0; index < sizeof(intrinsics) / sizeof(intrinsic_t); index++) {
+        const intrinsic_t *intrinsic = &intrinsics[index];
+        if (intrinsic->arg_count == expr->args_count
+                && wcslen(intrinsic->name) == var->name.length
+                && wmemcmp(intrinsic->name, var->name.data, var->name.length) == 0) {
+            return intrinsic;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Finds the instruction creating the called function, if it is known at compile time.
+ * 
+ * The function is known if the called object is a constant initialized with a function
+ * literal whose bytecode has already been generated.
+ * 
+ * @param func_object The expression that evaluates to the called object.
+ * @return The index of the `FUNC` instruction, or `BAD_INSTR_INDEX` if the function is unknown.
+ */
+static instr_index_t find_known_function(const expression_t *func_object) {
+    if (func_object->base.vtbl->type != NODE_VARIABLE) {
+        return BAD_INSTR_INDEX;
+    }
+    const declarator_t *declarator = ((const variable_t *)func_object)->declarator;
+    if (declarator == NULL || declarator == get_builtin_declarator()
+            || declarator->base.vtbl->type != NODE_CONSTANT_DECLARATOR) {
+        return BAD_INSTR_INDEX;
+    }
+    const node_t *initial = get_node_child(&declarator->base, 0);
+    if (initial == NULL || initial->vtbl->type != NODE_FUNCTION_OBJECT) {
+        return BAD_INSTR_INDEX;
+    }
+    return get_function_creation_instruction(initial);
+}
+
 /**
  * @brief Generates bytecode for a function call expression.
  * 
  * This function generates the bytecode for a function call expression. It processes the arguments
  * of the function call first, generating the bytecode for each argument by iterating through the
  * list of arguments in reverse order. Then, it generates the bytecode for the function object
- * itself. Finally, it adds a `CALL` instruction to the bytecode, with the argument count.
+ * itself. Finally, it adds a `CALL` instruction to the bytecode, with the argument count, or
+ * a `CALLK` instruction if the called function is a constant bound to a known function literal.
+ * A call of a built-in function that has an intrinsic instruction is compiled into that
+ * instruction alone, without loading the function object.
  * 
  * @param node A pointer to the function call node in the abstract syntax tree.
  * @param code A pointer to the `code_builder_t` structure, which is used to build the instructions.
@@ -220,8 +324,20 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
             generate_bytecode_from_expression(arg, code, data);
         } while (index > 0);
     }
+    const intrinsic_t *intrinsic = find_intrinsic(expr);
+    if (intrinsic != NULL) {
+        add_instruction(code, (instruction_t){ .opcode = intrinsic->opcode });
+        return first;
+    }
     generate_bytecode_from_expression(expr->func_object, code, data);
-    add_instruction(code, (instruction_t){ .opcode = CALL, .arg0 = (uint16_t)expr->args_count });
+    instr_index_t site = find_known_function(expr->func_object);
+    if (site != BAD_INSTR_INDEX) {
+        add_instruction(code, (instruction_t){ .opcode = CALLK,
+            .arg0 = (uint16_t)expr->args_count, .arg1 = site });
+    } else {
+        add_instruction(code,
+            (instruction_t){ .opcode = CALL, .arg0 = (uint16_t)expr->args_count });
+    }
     return first;
 }
 
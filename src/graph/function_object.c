@@ -15,6 +15,7 @@
 #include "statement.h"
 #include "statement_sequence.h"
 #include "declarations.h"
+#include "scope.h"
 #include "lib/allocate.h"
 #include "lib/arena.h"
 #include "lib/linked_list.h"
@@ -672,7 +673,9 @@ static void fobj_generate_indented_goat_code(const node_t *node, source_builder_
  * 
  * This function emits the initial instruction(s) required to represent a function object
  * in the bytecode stream. It prepares a placeholder instruction (`ARG`) for body address
- * and emits a  `FUNC` instruction with encoded parameter information.
+ * and emits a  `FUNC` instruction with encoded parameter information. If the environment
+ * of the function can not escape, the instruction is marked with `FUNCTION_IN_FRAME` and
+ * the number of local variable slots follows the argument names.
  * 
  * The actual function body is not generated here — that is handled by `generate_bytecode_deferred`.
  * 
@@ -688,16 +691,21 @@ static instr_index_t fobj_generate_bytecode(node_t *node, code_builder_t *code,
         code,
         (instruction_t){ .opcode = ARG, .arg1 = 0xFFFFFFFF } // placeholder
     );
+    const scope_t *scope = node->scope;
+    size_t arg_count = expr->arguments->arg_count;
     uint32_t arg_names_idx = 0;
-    if (expr->arguments->arg_count > 0) {
-        size_t arg_size = expr->arguments->arg_count * sizeof(uint32_t);
+    if (arg_count > 0 || !scope->escapes) {
+        size_t arg_size = (scope->escapes ? arg_count : arg_count + 1) * sizeof(uint32_t);
         uint32_t *arg_names = (uint32_t*)ALLOC(arg_size);
-        for (size_t index = 0; index < expr->arguments->arg_count; index++) {
+        for (size_t index = 0; index < arg_count; index++) {
             arg_names[index] = add_string_to_data_segment_ex(
                 data,
                 expr->arguments->arg_list[index]->base.name
             );
         }
+        if (!scope->escapes) {
+            arg_names[arg_count] = scope->slot_count;
+        }
         arg_names_idx = add_data_to_data_segment(data, arg_names, arg_size);
         FREE(arg_names);
     }
@@ -705,7 +713,8 @@ static instr_index_t fobj_generate_bytecode(node_t *node, code_builder_t *code,
         code,
         (instruction_t) {
             .opcode = FUNC,
-            .arg0 = (uint16_t)expr->arguments->arg_count,
+            .flags = scope->escapes ? 0 : FUNCTION_IN_FRAME,
+            .arg0 = (uint16_t)arg_count,
             .arg1 = arg_names_idx
         }
     );
@@ -808,3 +817,12 @@ void fill_function_body(node_t *node, list_t *statements) {
     fobj->body->statements = statements;
     fobj->code_instr_index = BAD_INSTR_INDEX;
 }
+
+instr_index_t get_function_creation_instruction(const node_t *node) {
+    assert(node->vtbl->type == NODE_FUNCTION_OBJECT);
+    const function_object_t *fobj = (const function_object_t *)node;
+    if (fobj->code_instr_index == BAD_INSTR_INDEX) {
+        return BAD_INSTR_INDEX;
+    }
+    return fobj->code_instr_index + 1; // FUNC follows the ARG instruction
+}
@@ -11,6 +11,7 @@
 
 #include "statement.h"
 #include "expression.h"
+#include "binary_operation.h"
 #include "common_methods.h"
 #include "lib/allocate.h"
 #include "lib/arena.h"
@@ -140,17 +141,26 @@ static const wchar_t* get_child_tag(const node_t *node, size_t index) {
  * eventually evaluate the condition abstractly, execute reachable branches, and
  * merge their resulting abstract states.
  * 
- * The current implementation is a placeholder and returns the input state
- * unchanged.
+ * For now the condition is calculated (it is evaluated before either branch,
+ * so the nodes inside it can record facts about their operands), and if its value
+ * is known at compile time, the branch that is always taken is executed as if it
+ * were not conditional. Otherwise, the branches are not analyzed and the input
+ * state is returned unchanged.
  * 
  * @param node The if-else statement node to execute.
  * @param state Current abstract state.
  * @param arena Arena used for lattice elements produced during branch analysis.
- * @return The resulting abstract state. Currently this is the same state that
- *         was passed in.
+ * @return The resulting abstract state.
  */
 static abstract_state_t *execute(node_t *node, abstract_state_t *state, arena_t *arena) {
-    // for now without implementation
+    const if_else_t* stmt = (const if_else_t*)node;
+    calculate_expression(stmt->condition, state, arena);
+    const lattice_element_t *value = get_constant_expression_value(stmt->condition);
+    if (value && value->type == LATTICE_TRUE) {
+        state = execute_statement(stmt->true_branch, state, arena);
+    } else if (value && value->type == LATTICE_FALSE && stmt->false_branch) {
+        state = execute_statement(stmt->false_branch, state, arena);
+    }
     return state;
 }
 
@@ -207,15 +217,50 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
     }
 }
 
+/**
+ * @brief Generates bytecode for the condition of an if-else statement.
+ * 
+ * A less-than comparison is fused with the conditional jump: the operands are emitted,
+ * followed by `JNLT` (or `IJNLT`, if the analysis has proven that both operands are
+ * integers). Any other condition is emitted as an expression followed by `JIF`.
+ * The target of the jump is left for the caller to patch.
+ * 
+ * @param condition The condition expression.
+ * @param code A pointer to the bytecode builder.
+ * @param data A pointer to the static data builder.
+ * @param jump_index Where to store the index of the conditional jump instruction.
+ * @return The instruction index of the first emitted instruction.
+ */
+static instr_index_t generate_condition(expression_t *condition, code_builder_t *code,
+        data_builder_t *data, instr_index_t *jump_index) {
+    if (condition->base.vtbl->type == NODE_LESS) {
+        const binary_operation_t *less = (const binary_operation_t *)condition;
+        instr_index_t first = generate_bytecode_from_expression(less->left_operand, code, data);
+        generate_bytecode_from_expression(less->right_operand, code, data);
+        *jump_index = add_instruction(code, (instruction_t){
+            .opcode = binop_get_operand_domain(less) == OPERANDS_INTEGER ? IJNLT : JNLT
+        });
+        return first;
+    }
+    instr_index_t first = generate_bytecode_from_expression(condition, code, data);
+    *jump_index = add_instruction(code, (instruction_t){ .opcode = JIF });
+    return first;
+}
+
 /**
  * @brief Generates bytecode for an if-else statement node.
  * 
- * The condition expression is emitted first. A `JIF` instruction is then used
- * to skip the true branch when the condition is false. If an else branch exists,
+ * The condition expression is emitted first. A `JIF` instruction (or a fused
+ * compare-and-branch instruction) is then used to skip the true branch when the
+ * condition is false. If an else branch exists,
  * a trailing `JUMP` instruction skips over that branch after the true branch has
  * finished executing. Jump targets are patched after the corresponding target
  * instruction indices become known.
  * 
+ * If the value of the condition is known at compile time, neither the condition
+ * nor the jumps are emitted, only the branch that is taken; the other branch
+ * is dropped from the bytecode.
+ * 
  * @param node A pointer to the if-else statement node.
  * @param code A pointer to the bytecode builder.
  * @param data A pointer to the static data builder.
@@ -224,8 +269,17 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
 static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
         data_builder_t *data) {
     const if_else_t* stmt = (const if_else_t*)node;
-    instr_index_t first = generate_bytecode_from_expression(stmt->condition, code, data); 
-    instr_index_t jif_index = add_instruction(code, (instruction_t){ .opcode = JIF });
+    const lattice_element_t *value = get_constant_expression_value(stmt->condition);
+    if (value && value->type == LATTICE_TRUE) {
+        return generate_bytecode_from_statement(stmt->true_branch, code, data);
+    }
+    if (value && value->type == LATTICE_FALSE) {
+        return stmt->false_branch
+            ? generate_bytecode_from_statement(stmt->false_branch, code, data)
+            : get_next_instruction_index(code);
+    }
+    instr_index_t jif_index;
+    instr_index_t first = generate_condition(stmt->condition, code, data, &jif_index);
     generate_bytecode_from_statement(stmt->true_branch, code, data);
     if (stmt->false_branch) {
         instr_index_t jump_index = add_instruction(code, (instruction_t){ .opcode = JUMP });
@@ -12,7 +12,6 @@
 #include "common_methods.h"
 #include "lib/arena.h"
 #include "lib/string_ext.h"
-#include "lib/split64.h"
 #include "analysis/lattice.h"
 #include "codegen/code_builder.h"
 #include "codegen/data_builder.h"
@@ -105,28 +104,18 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
  * @brief Generates bytecode for an integer node.
  * 
  * This function generates bytecode for an integer node by emitting either:
- * - An `ILOAD32` instruction for values fitting in 32 bits (range [-2^31, 2^31-1])
- * - An `ILOAD64` instruction with `ARG` prefix for 64-bit values
+ * - An `ILOAD32` instruction for values that fit into a tagged integer
+ * - An `ILOADK` instruction referring to a constant in the data segment for larger values
  * 
  * @param node A pointer to the node representing an integer literal.
  * @param code A pointer to the `code_builder_t` structure for instruction generation.
- * @param data Unused parameter (kept for signature compatibility with other generators).
+ * @param data A pointer to the `data_builder_t` that receives large constants.
  * @return The instruction index of the first emitted instruction.
  */
 static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
         data_builder_t *data) {
     const integer_t *expr = (const integer_t *)node;
-    int64_t value = expr->element.value;
-    instr_index_t first;
-    if (value > INT32_MAX || value < INT32_MIN) {
-        split64_t s;
-        s.int_value = value;
-        first = add_instruction(code, (instruction_t){ .opcode = ARG, .arg1 = s.parts[0] });
-        add_instruction(code, (instruction_t){ .opcode = ILOAD64, .arg1 = s.parts[1] });
-    } else {
-        first = add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = value });
-    }
-    return first;
+    return generate_bytecode_for_integer(expr->element.value, code, data);
 }
 
 /**
@@ -13,6 +13,7 @@
 #include "lib/allocate.h"
 #include "lib/arena.h"
 #include "lib/string_ext.h"
+#include "analysis/lattice.h"
 #include "codegen/code_builder.h"
 #include "codegen/data_builder.h"
 #include "codegen/source_builder.h"
@@ -31,6 +32,40 @@ typedef struct {
     binary_operation_t base;
 } less_t;
 
+/**
+ * @brief Calculates the abstract lattice element produced by the `<` operation.
+ * 
+ * Comparison always produces a boolean; two numeric constants give a constant. The abstract
+ * values of the operands are recorded in the node, so that code generation can choose
+ * a specialized instruction.
+ * 
+ * @param node A pointer to the less-than expression node.
+ * @param state Current abstract state.
+ * @param arena Memory arena used for allocating lattice elements.
+ * @return Abstract value produced by the comparison.
+ */
+static const lattice_element_t *calculate(node_t *node, abstract_state_t *state, arena_t *arena) {
+    binary_operation_t *expr = (binary_operation_t *)node;
+    const lattice_element_t *left = calculate_expression(expr->left_operand, state, arena);
+    const lattice_element_t *right = calculate_expression(expr->right_operand, state, arena);
+    binop_record_operand_values(expr, arena, left, right);
+    if (left->type == LATTICE_BOTTOM || right->type == LATTICE_BOTTOM) {
+        return make_bottom_element();
+    }
+    if (left->type == LATTICE_INTEGER_CONSTANT && right->type == LATTICE_INTEGER_CONSTANT) {
+        return ((const integer_constant_element_t *)left)->value
+            < ((const integer_constant_element_t *)right)->value
+            ? make_true_element() : make_false_element();
+    }
+    double left_real, right_real;
+    if (binop_get_numeric_constant(left, &left_real)
+            && binop_get_numeric_constant(right, &right_real)) {
+        // numbers are compared by the sign of their difference, as at run time
+        return left_real - right_real < 0 ? make_true_element() : make_false_element();
+    }
+    return make_boolean_element();
+}
+
 /**
  * @brief Converts a less-than operation expression to its string representation.
  * 
@@ -76,7 +111,8 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
  * @brief Generates bytecode for a less-than operation node.
  * 
  * This function generates bytecode for a less-than comparison by first generating the bytecode
- * for the left and right operands, and then emitting the `LESS` instruction for the comparison.
+ * for the left and right operands, and then emitting the `LESS` instruction for the comparison,
+ * or `ILESS` / `RLESS` if the analysis has proven that the operands are numbers.
  * 
  * @param node A pointer to the node representing the less-than operation.
  * @param code A pointer to the `code_builder_t` structure used for generating instructions.
@@ -88,7 +124,7 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
     const less_t *expr = (const less_t *)node;
     instr_index_t first = generate_bytecode_from_expression(expr->base.left_operand, code, data);
     generate_bytecode_from_expression(expr->base.right_operand, code, data);
-    add_instruction(code, (instruction_t){ .opcode = LESS });
+    binop_add_instruction(&expr->base, code, LESS, ILESS, RLESS, NULL);
     return first;
 }
 
@@ -113,7 +149,7 @@ static node_vtbl_t less_vtbl = {
     .get_related_count = no_related_nodes,
     .get_related = no_related_node,
     .get_relation_type = no_relation_type,
-    .calculate = cannot_calculate,
+    .calculate = calculate,
     .execute = execute_nothing,
     .generate_goat_code = generate_goat_code,
     .generate_indented_goat_code = generate_indented_goat_code,
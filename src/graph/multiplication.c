@@ -12,6 +12,7 @@
 #include "lib/allocate.h"
 #include "lib/arena.h"
 #include "lib/string_ext.h"
+#include "analysis/lattice.h"
 #include "codegen/code_builder.h"
 #include "codegen/data_builder.h"
 #include "codegen/source_builder.h"
@@ -31,6 +32,58 @@ typedef struct {
     binary_operation_t base;
 } multiplication_t;
 
+/**
+ * @brief Multiplies two integers, checking for overflow.
+ * @param first The first integer.
+ * @param second The second integer.
+ * @param out Where to store the product.
+ * @return `true` if the product fits into 64 bits.
+ */
+static bool multiply_integers_checked(int64_t first, int64_t second, int64_t *out) {
+    bool overflow;
+    if (first > 0) {
+        overflow = second > 0 ? first > INT64_MAX / second : second < INT64_MIN / first;
+    } else {
+        overflow = second > 0 ? first < INT64_MIN / second
+            : first != 0 && second < INT64_MAX / first;
+    }
+    if (overflow) {
+        return false;
+    }
+    *out = first * second;
+    return true;
+}
+
+/**
+ * @brief Multiplies two real numbers.
+ * @param first The first number.
+ * @param second The second number.
+ * @return The product.
+ */
+static double multiply_reals(double first, double second) {
+    return first * second;
+}
+
+/**
+ * @brief Calculates the abstract lattice element produced by the `*` operation.
+ * 
+ * The abstract values of the operands are recorded in the node, so that code generation can
+ * choose a specialized instruction.
+ * 
+ * @param node A pointer to the multiplication expression node.
+ * @param state Current abstract state.
+ * @param arena Memory arena used for allocating lattice elements.
+ * @return Abstract value produced by the multiplication.
+ */
+static const lattice_element_t *calculate(node_t *node, abstract_state_t *state, arena_t *arena) {
+    binary_operation_t *expr = (binary_operation_t *)node;
+    const lattice_element_t *left = calculate_expression(expr->left_operand, state, arena);
+    const lattice_element_t *right = calculate_expression(expr->right_operand, state, arena);
+    binop_record_operand_values(expr, arena, left, right);
+    return binop_calculate_arithmetic(arena, left, right,
+        multiply_integers_checked, multiply_reals);
+}
+
 /**
  * @brief Converts a multiplication operation expression to its string representation.
  * 
@@ -70,11 +123,22 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
     generate_indented_goat_code_from_expression(expr->base.right_operand, builder, indent);
 }
 
+/**
+ * @brief Multiplies two integers.
+ * @param first The first integer.
+ * @param second The second integer.
+ * @return The product.
+ */
+static int64_t multiply_integers(int64_t first, int64_t second) {
+    return first * second;
+}
+
 /**
  * @brief Generates bytecode for a multiplication operation node.
  * 
  * This function generates bytecode for a multiplication operation by first generating the bytecode
- * for the left and right operands, and then generating the `MUL` instruction.
+ * for the left and right operands, and then generating the `MUL` instruction,
+ * or `IMUL` / `RMUL` if the analysis has proven that the operands are numbers.
  * 
  * @param node A pointer to the node representing the multiplication operation.
  * @param code A pointer to the `code_builder_t` structure used for generating instructions.
@@ -86,7 +150,7 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
     const multiplication_t *expr = (const multiplication_t *)node;
     instr_index_t first = generate_bytecode_from_expression(expr->base.left_operand, code, data);
     generate_bytecode_from_expression(expr->base.right_operand, code, data);
-    add_instruction(code, (instruction_t){ .opcode = MUL });
+    binop_add_instruction(&expr->base, code, MUL, IMUL, RMUL, multiply_integers);
     return first;
 }
 
@@ -111,7 +175,7 @@ static node_vtbl_t multiplication_vtbl = {
     .get_related_count = no_related_nodes,
     .get_related = no_related_node,
     .get_relation_type = no_relation_type,
-    .calculate = cannot_calculate,
+    .calculate = calculate,
     .execute = execute_nothing,
     .generate_goat_code = generate_goat_code,
     .generate_indented_goat_code = generate_indented_goat_code,
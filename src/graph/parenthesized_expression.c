@@ -80,6 +80,21 @@ static const wchar_t* get_child_tag(const node_t *node, size_t index) {
     return (index == 0) ? L"expression" : NULL;
 }
 
+/**
+ * @brief Calculates the abstract value of a parenthesized expression.
+ *
+ * Parentheses do not change the value, so the inner expression is calculated.
+ *
+ * @param node A pointer to the parenthesized expression node.
+ * @param state Current abstract state.
+ * @param arena Memory arena used for allocating lattice elements.
+ * @return Abstract value of the inner expression.
+ */
+static const lattice_element_t *calculate(node_t *node, abstract_state_t *state, arena_t *arena) {
+    const parenthesized_expression_t *expr = (const parenthesized_expression_t *)node;
+    return calculate_expression(expr->inner, state, arena);
+}
+
 /**
  * @brief Converts the parenthesized expression to its string representation.
  *
@@ -153,7 +168,7 @@ static node_vtbl_t expression_parenthesized_vtbl = {
     .get_related_count = no_related_nodes,
     .get_related = no_related_node,
     .get_relation_type = no_relation_type,
-    .calculate = cannot_calculate,
+    .calculate = calculate,
     .execute = execute_nothing,
     .generate_goat_code = generate_goat_code,
     .generate_indented_goat_code = generate_indented_goat_code,
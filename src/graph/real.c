@@ -12,7 +12,6 @@
 #include "common_methods.h"
 #include "lib/arena.h"
 #include "lib/string_ext.h"
-#include "lib/split64.h"
 #include "analysis/lattice.h"
 #include "codegen/code_builder.h"
 #include "codegen/data_builder.h"
@@ -102,27 +101,18 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
 /**
  * @brief Generates bytecode for a real number literal node.
  * 
- * Emits:
- * - An `ARG` instruction for the lower 32 bits of the `double` value.
- * - An `RLOAD` instruction for the upper 32 bits.
- * Together, they form the full 64-bit representation of the real number.
+ * Emits an `RLOADK` instruction referring to the value placed into the data segment,
+ * so the real number object is created only once per process.
  * 
  * @param node A pointer to the real number literal node.
  * @param code A pointer to the code builder for instruction emission.
- * @param data Unused (present for compatibility).
- * @return Index of the first emitted instruction.
+ * @param data A pointer to the data builder that receives the constant.
+ * @return Index of the emitted instruction.
  */
 static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
         data_builder_t *data) {
     const real_t *expr = (const real_t *)node;
-    split64_t s;
-    s.real_value = expr->element.value;
-    instr_index_t first = add_instruction(
-        code,
-        (instruction_t){ .opcode = ARG, .arg1 = s.parts[0] }
-    );
-    add_instruction(code, (instruction_t){ .opcode = RLOAD, .arg1 = s.parts[1] });
-    return first;
+    return generate_bytecode_for_real(expr->element.value, code, data);
 }
 
 /**
@@ -8,6 +8,8 @@
  * This implementation handles semantic representation and bytecode generation for return logic.
  */
 
+#include <assert.h>
+
 #include "statement.h"
 #include "expression.h"
 #include "common_methods.h"
@@ -178,6 +180,8 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
  * If the return statement includes a value, bytecode is generated for the value expression
  * first. Otherwise, a `NIL` instruction is emitted to represent an empty return.
  * In both cases, a `RET` instruction is added at the end to complete the return operation.
+ * A returned function call is a tail call: its `CALL` (or `CALLK`) instruction is replaced with
+ * `TAILCALL`; calls compiled into intrinsic instructions are left as they are.
  * 
  * @param node A pointer to the return statement node.
  * @param code A pointer to the bytecode builder.
@@ -190,6 +194,13 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
     instr_index_t first;
     if (stmt->value) {
         first = generate_bytecode_from_expression(stmt->value, code, data);
+        instruction_t *call = &code->instructions[code->size - 1];
+        if (stmt->value->base.vtbl->type == NODE_FUNCTION_CALL
+                && (call->opcode == CALL || call->opcode == CALLK)) {
+            // the call is in tail position: let it reuse the frame of the current function,
+            // RET only returns the result if the frame can not be reused
+            *call = (instruction_t){ .opcode = TAILCALL, .arg0 = call->arg0 };
+        }
     } else {
         first = add_instruction(code, (instruction_t){ .opcode = NIL });
     }
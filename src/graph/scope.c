@@ -21,6 +21,8 @@ scope_t *create_scope(arena_t *arena, scope_t *parent) {
     scope->id = ++last_id;
     scope->parent = parent;
     scope->bindings = create_avl_tree_arena(arena, string_comparator);
+    scope->slot_count = 0;
+    scope->escapes = false;
     return scope;
 }
 
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #include "lib/value.h"
 #include "lib/avl_tree.h"
 
@@ -65,6 +67,23 @@ struct scope_t {
      * Keys are identifier names, values are pointers to the corresponding AST nodes.
      */
     avl_tree_arena_t *bindings;
+
+    /**
+     * @brief Number of slots allocated for the declarators of this scope.
+     *
+     * Incremented by the static analysis as it numbers the declarators.
+     */
+    unsigned int slot_count;
+
+    /**
+     * @brief Whether the environment of this scope can escape.
+     *
+     * The environment escapes if it can be reached after the scope is left or through
+     * an object: a function created in the scope captures it, or the value of the block is
+     * used. Such a scope is a heap object at run time; any other scope is executed with
+     * a lightweight frame that keeps its variables in slots. Set by the static analysis.
+     */
+    bool escapes;
 };
 
 /**
@@ -11,6 +11,7 @@
 
 #include "common_methods.h"
 #include "expression.h"
+#include "scope.h"
 #include "statement.h"
 #include "statement_sequence.h"
 #include "lib/allocate.h"
@@ -192,6 +193,9 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
  * 2) emit bytecode for all statements within that environment
  * 3) LEAVE — restore the previous context, preserving the block's result
  *
+ * If the environment of the block can not escape, ENTERF and LEAVEF are emitted instead:
+ * the block is executed in a frame and its result is `null`.
+ *
  * @param node Pointer to the statement list node.
  * @param code Code builder receiving emitted instructions.
  * @param data Data builder for the constant pool.
@@ -200,7 +204,10 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
 static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
         data_builder_t *data) {
     const statement_list_t* list = (const statement_list_t*)node;
-    instr_index_t first = add_instruction(code, (instruction_t){ .opcode = ENTER });
+    const scope_t *scope = node->scope;
+    instr_index_t first = scope->escapes
+        ? add_instruction(code, (instruction_t){ .opcode = ENTER })
+        : add_instruction(code, (instruction_t){ .opcode = ENTERF, .arg1 = scope->slot_count });
 
     list_item_t *item = list->statements->head;
     while (item) {
@@ -209,7 +216,7 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
         item = item->next;
     }
 
-    add_instruction(code, (instruction_t){ .opcode = LEAVE });
+    add_instruction(code, (instruction_t){ .opcode = scope->escapes ? LEAVE : LEAVEF });
     return first;
 }
 
@@ -13,6 +13,7 @@
 #include "common_methods.h"
 #include "statement.h"
 #include "declarations.h"
+#include "scope.h"
 #include "lib/allocate.h"
 #include "lib/arena.h"
 #include "lib/string_ext.h"
@@ -157,12 +158,45 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
     append_formatted_source(builder, VIEW_TO_VALUE(expr->name));
 }
 
+/**
+ * @brief Resolves the run-time address of a variable as a pair (depth, slot).
+ * 
+ * Every scope is a context at run time, so the depth is the number of scopes between the scope
+ * of the variable usage and the scope of its declaration, and the slot is the index assigned
+ * to the declarator by the static analysis. Built-in names and variables that were not bound
+ * to a declarator have no such address and must be looked up by name.
+ * 
+ * @param expr Pointer to the variable node.
+ * @param instr Instruction whose `flags` (depth) and `arg0` (slot) fields are filled.
+ * @return `true` if the address was resolved, `false` otherwise.
+ */
+static bool resolve_slot(const variable_t *expr, instruction_t *instr) {
+    const declarator_t *declarator = expr->declarator;
+    if (declarator == NULL || declarator == get_builtin_declarator()
+            || declarator->base.scope == NULL || declarator->slot > UINT16_MAX) {
+        return false;
+    }
+    unsigned int depth = 0;
+    const scope_t *scope = expr->base.base.base.scope;
+    while (scope != NULL && scope != declarator->base.scope) {
+        scope = scope->parent;
+        depth++;
+    }
+    if (scope == NULL || depth > UINT8_MAX) {
+        return false;
+    }
+    instr->flags = (uint8_t)depth;
+    instr->arg0 = (uint16_t)declarator->slot;
+    return true;
+}
+
 /**
  * @brief Generates bytecode for a variable node.
  * 
  * This function generates bytecode for a variable node by first adding the variable's name
- * to the data segment, and then generating a `VLOAD` instruction with the index of the variable's
- * name in the data segment.
+ * to the data segment, and then generating a `LLOAD` instruction addressing the variable by
+ * its slot, or a `VLOAD` instruction with the index of the variable's name in the data segment
+ * if the slot is unknown.
  * 
  * @param node A pointer to the node representing a variable.
  * @param code A pointer to the `code_builder_t` structure used for generating instructions.
@@ -172,8 +206,12 @@ static void generate_indented_goat_code(const node_t *node, source_builder_t *bu
 static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
         data_builder_t *data) {
     const variable_t *expr = (const variable_t *)node;
-    uint32_t index = add_string_to_data_segment_ex(data, expr->name);
-    return add_instruction(code, (instruction_t){ .opcode = VLOAD, .arg1 = index });
+    instruction_t instr = { .opcode = VLOAD };
+    if (resolve_slot(expr, &instr)) {
+        instr.opcode = LLOAD;
+    }
+    instr.arg1 = add_string_to_data_segment_ex(data, expr->name);
+    return add_instruction(code, instr);
 }
 
 /**
@@ -181,7 +219,8 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
  * 
  * This function implements the assignment operation for variable nodes by:
  * 1. Adding the variable's name to the data segment (if not already present)
- * 2. Generating a STORE instruction with the variable's data segment index
+ * 2. Generating a LSTORE instruction addressing the variable by its slot, or a STORE instruction
+ *    with the variable's data segment index if the slot is unknown
  * 
  * @param node A pointer to the variable node (must be of variable type)
  * @param code Code builder for instruction generation
@@ -191,8 +230,12 @@ static instr_index_t generate_bytecode(node_t *node, code_builder_t *code,
 static instr_index_t generate_bytecode_assign(const node_t *node, code_builder_t *code,
         data_builder_t *data) {
     const variable_t *expr = (const variable_t *)node;
-    uint32_t index = add_string_to_data_segment_ex(data, expr->name);
-    return add_instruction(code, (instruction_t){ .opcode = STORE, .arg1 = index });
+    instruction_t instr = { .opcode = STORE };
+    if (resolve_slot(expr, &instr)) {
+        instr.opcode = LSTORE;
+    }
+    instr.arg1 = add_string_to_data_segment_ex(data, expr->name);
+    return add_instruction(code, instr);
 }
 
 /**
@@ -45,7 +45,7 @@ static object_vtbl_t boolean_proto_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -57,6 +57,8 @@ static object_vtbl_t boolean_proto_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -214,7 +216,7 @@ static object_vtbl_t false_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare,
     .clone = clone_singleton,
@@ -226,6 +228,8 @@ static object_vtbl_t false_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -260,7 +264,7 @@ static object_vtbl_t true_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare,
     .clone = clone_singleton,
@@ -272,6 +276,8 @@ static object_vtbl_t true_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
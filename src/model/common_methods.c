@@ -16,10 +16,6 @@ void stub_memory_function(object_t *obj) {
     return;
 }
 
-bool no_sweep(object_t *obj) {
-    return false;
-}
-
 int compare_object_addresses(const object_t *obj1, const object_t *obj2) {
     if (obj1 > obj2) {
         return 1;
@@ -85,6 +81,15 @@ model_status_t set_property_on_immutable(object_t *obj, object_t *key, object_t
     return MSTAT_IMMUTABLE_OBJECT;
 }
 
+object_t *no_property_by_index(const object_t *obj, size_t index, const object_t *key) {
+    return NULL;
+}
+
+model_status_t set_property_by_index_on_immutable(object_t *obj, size_t index,
+        const object_t *key, object_t *value) {
+    return MSTAT_IMMUTABLE_OBJECT;
+}
+
 object_t *stub_add(process_t *process, object_t *obj1, object_t *obj2) {
     return NULL;
 }
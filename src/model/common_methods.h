@@ -19,15 +19,6 @@
  */
 void stub_memory_function(object_t *obj);
 
-/**
- * @brief A stub sweep function for objects that should never be swept (like singletons).
- * @param obj The object. This parameter is unused.
- * @return Always returns false since the object should never be collected.
- * @note This function is used for permanent objects that should never participate
- *       in garbage collection (e.g., singletons, global constants).
- */
-bool no_sweep(object_t *obj);
-
 /**
  * @brief Compares the memory addresses of two objects.
  * 
@@ -137,6 +128,34 @@ model_status_t create_property_on_immutable(object_t *obj, object_t *key, object
  */
 model_status_t set_property_on_immutable(object_t *obj, object_t *key, object_t *value);
 
+/**
+ * @brief Common function for retrieving a property by index from objects without
+ *  indexed properties.
+ * 
+ * Most objects do not store their properties in the order of creation, so the lookup by index
+ * always fails and the caller has to use the lookup by key.
+ * 
+ * @param obj The object from which to retrieve the property.
+ * @param index The index of the property.
+ * @param key The expected key of the property.
+ * @return Always returns `NULL`.
+ */
+object_t *no_property_by_index(const object_t *obj, size_t index, const object_t *key);
+
+/**
+ * @brief Stub for setting a property by index on an immutable object.
+ * 
+ * Immutable objects cannot have their properties modified, so the function always fails.
+ * 
+ * @param obj The immutable object on which the property setting was attempted.
+ * @param index The index of the property.
+ * @param key The expected key of the property.
+ * @param value The value to assign to the property.
+ * @return Always returns `MSTAT_IMMUTABLE_OBJECT`, indicating that the operation is not supported.
+ */
+model_status_t set_property_by_index_on_immutable(object_t *obj, size_t index,
+        const object_t *key, object_t *value);
+
 /**
  * @brief Stub implementation for the `add` operation on unsupported objects.
  * 
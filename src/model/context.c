@@ -23,10 +23,33 @@ context_t *create_context(process_t *process, context_t *caller, object_t *proto
     ctx->ret_address = BAD_INSTR_INDEX;
     ctx->ret_value_index = caller->ret_value_index;
     ctx->unwinding_index = BAD_STACK_INDEX;
+    ctx->frame = false;
+    ctx->locals = NULL;
+    ctx->local_count = 0;
+    return ctx;
+}
+
+context_t *create_frame(context_t *caller, object_t *environment, size_t local_count) {
+    context_t *ctx = (context_t *)ALLOC(sizeof(context_t) + local_count * sizeof(object_t*));
+    ctx->data = environment;
+    INCREF(environment);
+    ctx->previous = caller;
+    ctx->ret_address = BAD_INSTR_INDEX;
+    ctx->ret_value_index = caller->ret_value_index;
+    ctx->unwinding_index = BAD_STACK_INDEX;
+    ctx->frame = true;
+    ctx->locals = (object_t **)(ctx + 1);
+    ctx->local_count = local_count;
+    for (size_t index = 0; index < local_count; index++) {
+        ctx->locals[index] = NULL;
+    }
     return ctx;
 }
 
 context_t *destroy_context(context_t *context) {
+    for (size_t index = 0; index < context->local_count; index++) {
+        DECREFIF(context->locals[index]);
+    }
     DECREF(context->data);
     context_t *previous = context->previous;
     FREE(context);
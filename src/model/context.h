@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #include "common/types.h"
 
 /**
@@ -89,6 +91,28 @@ struct context_t {
      * ret_value_index; for other constructs, it may differ.
      */
     stack_index_t unwinding_index;
+
+    /**
+     * @brief Whether the context is a frame.
+     *
+     * A frame is the context of a scope whose environment can not escape. It keeps its
+     * variables in `locals`, addressed by slot, and does not create a data object: its `data`
+     * refers to the nearest enclosing environment that is an object (the closure for
+     * a function, the environment of the enclosing scope for a block), which serves name
+     * lookups. The lexical parent of a block frame is the previous context.
+     */
+    bool frame;
+
+    /**
+     * @brief Local variables of a frame, indexed by slot; `NULL` entries are variables
+     *  whose declarations have not been executed yet.
+     */
+    object_t **locals;
+
+    /**
+     * @brief The number of local variable slots of a frame.
+     */
+    size_t local_count;
 };
 
 /**
@@ -121,11 +145,26 @@ context_t *get_root_context();
  */
 context_t *create_context(process_t *process, context_t *caller, object_t *proto);
 
+/**
+ * @brief Creates a new frame and links it to the caller context.
+ * 
+ * Allocates the context together with its local variable slots, which are all empty.
+ * No data object is created; the frame refers to the given environment instead.
+ * 
+ * @param caller A pointer to the calling context (used as the parent).
+ * @param environment The nearest enclosing environment that is an object.
+ * @param local_count The number of local variable slots.
+ * 
+ * @return A pointer to the newly created frame.
+ */
+context_t *create_frame(context_t *caller, object_t *environment, size_t local_count);
+
 /**
  * @brief Destroys an execution context and returns the previous context.
  * 
  * This function deallocates the memory associated with the given execution context. It also
- * decrements the reference count of the context's data, freeing it if no longer in use.
+ * decrements the reference count of the context's data (and of the local variables of
+ * a frame), freeing it if no longer in use.
  * The data object of the destroyed context is no longer available, but the previous context
  * (from which the current context inherited) is returned, allowing the caller to restore it
  * as the active context.
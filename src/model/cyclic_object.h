@@ -0,0 +1,74 @@
+/**
+ * @file cyclic_object.h
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Common part of objects that can be part of reference cycles.
+ *
+ * User-defined objects and functions hold references to other objects and count references
+ * to themselves, so they can form cycles that reference counting alone never frees. When
+ * a reference to such an object is dropped and the object stays alive, it may have just
+ * become the entry of a garbage cycle; it is then recorded as a possible root, and the cycle
+ * collector later checks the possible roots by trial deletion.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "object.h"
+#include "object_state.h"
+#include "process.h"
+#include "lib/vector.h"
+
+/**
+ * @struct cyclic_object_t
+ * @brief The beginning of every object that can be part of a reference cycle.
+ *
+ * Objects whose virtual table has the `push_children` function start with these fields,
+ * in this order, so the cycle collector can handle them without knowing their types.
+ * The reference count and the color used by the cycle collector are in the header.
+ */
+typedef struct {
+    /**
+     * @brief The base object that provides common functionality.
+     */
+    object_t base;
+
+    /**
+     * @brief One-based index of the object in the possible roots of the process, or 0 if
+     *  the object is not recorded there.
+     */
+    size_t root_index;
+} cyclic_object_t;
+
+/**
+ * @brief Checks whether an object can be part of a reference cycle.
+ * @param obj The object.
+ * @return `true` if the object begins with `cyclic_object_t`.
+ */
+static inline bool is_cyclic_object(const object_t *obj) {
+    return !is_tagged_integer(obj) && obj->vtbl->push_children != NULL;
+}
+
+/**
+ * @brief Records an object, whose reference count has been decremented but not to zero,
+ *  as a possible root of a garbage cycle.
+ * @param obj The object; nothing is done if it has already been recorded.
+ */
+static inline void add_possible_root(cyclic_object_t *obj) {
+    if (obj->root_index == 0) {
+        vector_t *roots = get_object_process(&obj->base)->possible_roots;
+        append_to_vector(roots, obj);
+        obj->root_index = roots->size;
+    }
+}
+
+/**
+ * @brief Removes an object that is being destroyed from the possible roots.
+ * @param obj The object; nothing is done if it has not been recorded.
+ */
+static inline void remove_possible_root(cyclic_object_t *obj) {
+    if (obj->root_index != 0) {
+        get_object_process(&obj->base)->possible_roots->data[obj->root_index - 1] = NULL;
+        obj->root_index = 0;
+    }
+}
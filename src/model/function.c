@@ -26,16 +26,20 @@
  *      they are no longer in scope when the function is executed.
  */
 
+#include <assert.h>
 #include <math.h>
 
 #include "object.h"
 #include "object_state.h"
+#include "cyclic_object.h"
 #include "context.h"
 #include "thread.h"
 #include "process.h"
+#include "function_template.h"
 #include "common_methods.h"
 #include "lib/allocate.h"
 #include "lib/io.h"
+#include "lib/string_ext.h"
 
 /**
  * @brief Retrieves all property keys from an object (stub implementation).
@@ -73,7 +77,7 @@ static object_vtbl_t function_proto_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -85,6 +89,8 @@ static object_vtbl_t function_proto_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -126,15 +132,12 @@ object_t *get_function_proto() {
  * the program's execution.
  * 
  * The `exec` function is responsible for executing the logic of the static function.
- * It operates as follows:
- * - Takes an array of arguments, already extracted from the stack (`args`).
- * - Accepts the count of arguments (`arg_count`) as a 16-bit unsigned integer.
- * - Receives a reference to the thread (`thread`) for accessing thread-specific resources or
- *   managing complex operations.
+ * It receives a borrowed view of the arguments, which stay on the data stack during the call,
+ * and the thread (`thread`) for accessing thread-specific resources. It returns the result
+ * of the execution; `NULL` means that the function has no result, and `null` is used instead.
  * 
- * The function returns an `object_t*` representing the result of the execution:
- * - The returned object cannot be `NULL`.
- * - If the function has no return value, a special `null` object is returned.
+ * Built-in functions are static objects; native functions registered by an embedder are
+ * allocated, but live as long as the registration.
  */
 typedef struct {
     /**
@@ -150,7 +153,7 @@ typedef struct {
     /**
      * @brief The wrapped executor function for the static function.
      */
-    object_t* (*exec)(object_t** args, uint16_t arg_count, thread_t *thread);
+    native_function_t exec;
 } object_static_function_t;
 
 /**
@@ -225,32 +228,30 @@ static object_array_t get_topology(const object_t *obj) {
  * @brief Executes a static function object.
  *
  * This function is the implementation of the `call` method for static function objects.
- * It retrieves arguments from the thread's data stack, invokes the function using `exec`,
- * and pushes the result back onto the stack.
+ * The function gets a view of the arguments in place on the thread's data stack, so nothing
+ * is copied or allocated; the arguments are popped after `exec` returns, and the result is
+ * pushed onto the stack.
  *
  * @param obj Pointer to the static function object.
  * @param arg_count The number of arguments passed to the function.
  * @param thread Pointer to the thread in which the function is executed.
- * @return `true` indicating the call was successful.
+ * @return `true` if the call was successful, `false` if the stack holds fewer objects than
+ *  the number of arguments.
  */
 static bool static_call(object_t *obj, uint16_t arg_count, thread_t *thread) {
     object_static_function_t *sfobj = (object_static_function_t *)obj;
-    object_t *ret_val;
-    if (arg_count == 0) {
-        ret_val = sfobj->exec(NULL, 0, thread);
-    } else {
-        object_t **args = ALLOC(arg_count * sizeof(object_t*));
-        uint16_t index;
-        for (index = 0; index < arg_count; index++) {
-            args[index] = pop_object_from_stack(thread->data_stack);
-        }
-        ret_val = sfobj->exec(args, arg_count, thread);
-        for (index = 0; index < arg_count; index++) {
-            DECREF(args[index]);
-        }
-        FREE(args);
+    object_stack_t *stack = thread->data_stack;
+    if (arg_count > stack->size) {
+        return false;
     }
-    push_object_onto_stack(thread->data_stack, ret_val);
+    size_t base = stack->size - arg_count;
+    native_arguments_t args = { stack->objects + base, arg_count };
+    object_t *ret_val = sfobj->exec(args, thread);
+    assert(stack->size == base + arg_count);
+    while (stack->size > base) {
+        DECREF(stack->objects[--stack->size]);
+    }
+    push_object_onto_stack(stack, ret_val != NULL ? ret_val : get_null_object());
     thread->instr_id++;
     return true;
 }
@@ -264,7 +265,7 @@ static object_vtbl_t static_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -276,6 +277,8 @@ static object_vtbl_t static_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -304,12 +307,12 @@ static object_vtbl_t static_vtbl = {
  * @param func_label A wide-character string representing the name of the function.
  */
 #define START_FUNCTION(func_name) \
-    static object_t *func_name##_exec(object_t** args, uint16_t arg_count, thread_t *thread) {
+    static object_t *func_name##_exec(native_arguments_t args, thread_t *thread) {
 
 #define END_FUNCTION(func_name, func_label) \
     } \
     static object_static_function_t func_name = { \
-        { &static_vtbl, NULL, NULL, NULL }, \
+        { &static_vtbl }, \
         func_label, \
         func_name##_exec \
     }; \
@@ -321,10 +324,9 @@ static object_vtbl_t static_vtbl = {
  * This function computes the angle in radians between the positive X-axis 
  * and the point (x, y) using the standard math function atan2(y, x).
  * 
- * @param args An array of object pointers, where:
- *             - args[0] is the Y coordinate (must be a real number)
- *             - args[1] is the X coordinate (must be a real number)
- * @param arg_count The number of arguments passed to the function.
+ * @param args The arguments, where:
+ *             - argument 0 is the Y coordinate (must be a real number)
+ *             - argument 1 is the X coordinate (must be a real number)
  * @param thread The current thread executing the function.
  * @return A new real number object containing the result in radians, or:
  *         - NULL if fewer than 2 arguments provided
@@ -338,11 +340,11 @@ static object_vtbl_t static_vtbl = {
  *       - If either argument is NaN, returns NaN
  */
 START_FUNCTION(function_atan)
-    if (arg_count < 2) {
+    if (args.count < 2) {
         return NULL;
     }
-    real_value_t y = get_object_real_value(args[0]);
-    real_value_t x = get_object_real_value(args[1]);
+    real_value_t y = get_object_real_value(get_native_argument(args, 0));
+    real_value_t x = get_object_real_value(get_native_argument(args, 1));
     if (!x.has_value || !y.has_value) {
         return NULL;
     }
@@ -356,8 +358,7 @@ END_FUNCTION(function_atan, L"atan");
  * This function converts the first argument to its string representation and then prints it
  * to the standard output.
  * 
- * @param args An array of object pointers, where args[0] is the object to print.
- * @param arg_count The number of arguments passed to the function.
+ * @param args The arguments, where argument 0 is the object to print.
  * @param thread The current thread executing the function.
  * @return A `null` object after the string is printed.
  * 
@@ -366,10 +367,10 @@ END_FUNCTION(function_atan, L"atan");
  *  If no arguments are provided, the function returns `NULL` without performing any actions.
  */
 START_FUNCTION(function_print)
-    if (arg_count < 1) {
+    if (args.count < 1) {
         return NULL;
     }
-    string_value_t str = convert_object_to_string(args[0]);
+    string_value_t str = convert_object_to_string(get_native_argument(args, 0));
     if (str.data) {
         print_utf8(str.data);
         FREE_STRING(str);
@@ -383,16 +384,15 @@ END_FUNCTION(function_print, L"print");
  * This function computes the sign of a real number passed as an argument.
  * It returns 1 if the number is positive, -1 if it is negative, and 0 if it is zero.
  * 
- * @param args An array of object pointers, where args[0] is the number to evaluate.
- * @param arg_count The number of arguments passed to the function.
+ * @param args The arguments, where argument 0 is the number to evaluate.
  * @param thread The current thread executing the function.
  * @return A static integer object representing the sign of the input number.
  */
 START_FUNCTION(function_sign)
-    if (arg_count < 1) {
+    if (args.count < 1) {
         return NULL;
     }
-    double value = get_object_real_value(args[0]).value;
+    double value = get_object_real_value(get_native_argument(args, 0)).value;
     int sign;
     if (value > 0) {
         sign = 1;
@@ -410,27 +410,42 @@ END_FUNCTION(function_sign, L"sign");
  * This function returns the square root of the first argument interpreted as a real number.
  * The result is returned as a dynamically created real number object.
  * 
- * @param args Array of object pointers, where args[0] is the input number.
- * @param arg_count Number of arguments passed to the function.
+ * @param args The arguments, where argument 0 is the input number.
  * @param thread Pointer to the executing thread.
  * @return A new real number object representing the square root, or `NULL` on error.
  */
 START_FUNCTION(function_sqrt)
-    if (arg_count < 1) {
+    if (args.count < 1) {
         return NULL;
     }
-    double value = get_object_real_value(args[0]).value;
+    double value = get_object_real_value(get_native_argument(args, 0)).value;
     double result = sqrt(value);
     return create_real_number_object(thread->process, result);
 END_FUNCTION(function_sqrt, L"sqrt");
 
+object_t *create_native_function_object(const wchar_t *name, native_function_t exec) {
+    object_static_function_t *obj = (object_static_function_t *)CALLOC(
+        sizeof(object_static_function_t));
+    obj->base.vtbl = &static_vtbl;
+    obj->name = WSTRDUP(name);
+    obj->exec = exec;
+    return &obj->base;
+}
+
+void destroy_native_function_object(object_t *obj) {
+    object_static_function_t *sfobj = (object_static_function_t *)obj;
+    assert(obj->vtbl == &static_vtbl);
+    FREE(sfobj->name);
+    FREE(sfobj);
+}
+
 /**
  * @brief Structure representing a dynamic function object.
  *
  * This structure defines a dynamically created function in the Goat programming language.
  * Dynamic functions are created during program execution (via the FUNC opcode) and contain:
- * - Their own argument definitions
- * - A reference to their starting instruction
+ * - A template shared by all functions created by the same instruction, with the argument
+ *   definitions and the starting instruction
  * - Full garbage collection support
  * - Lexical closure environment
  * 
@@ -446,29 +461,14 @@ typedef struct {
     object_t base;
 
     /**
-     * @brief Reference count used for garbage collection.
-     */
-    int refs;
-
-    /**
-     * @brief The state of the object (unmarked, marked, zombie, or dying).
+     * @brief One-based index of the object in the possible roots of garbage cycles, or 0.
      */
-    object_state_t state;
+    size_t root_index;
 
     /**
-     * @brief Array of argument name objects.
+     * @brief The template of the function: argument names and the entry point.
      */
-    object_t **arg_names;
-
-    /**
-     * @brief The number of arguments the function accepts.
-     */
-    size_t arg_count;
-
-    /**
-     * @brief The starting instruction ID for this function.
-     */
-    instr_index_t first_instr_id;
+    const function_template_t *tmpl;
 
     /**
      * @brief The lexical closure environment of the function.
@@ -482,36 +482,28 @@ typedef struct {
     object_t *closure;
 } object_dynamic_function_t;
 
+static_assert(offsetof(object_dynamic_function_t, root_index)
+    == offsetof(cyclic_object_t, root_index),
+    "A dynamic function must begin with the fields of a cyclic object");
+
 /**
- * @brief Releases or clears a dynamic function object.
- * 
- * This function handles cleanup of dynamic function objects with two modes:
- * 
- * Deep cleaning (used by `dec_ref`):
- * - Decrements references for all argument name objects
- * - Ensures proper cleanup of referenced resources
+ * @brief Destroys a dynamic function object with optional deep cleaning.
  * 
- * Shallow cleaning (used by `sweep`):
- * - Only frees immediate object memory
- * - Leaves argument names for garbage collector to handle
- * 
- * Unlike other objects, dynamic functions are always immediately destroyed (no zombie state),
- * don't utilize an object pool (destruction is infrequent).
+ * Deep cleaning (used by `dec_ref`) decrements the reference count of the closure;
+ * shallow cleaning (used by `sweep`) leaves the closure for garbage collector to handle.
+ * Either way the slot of the object is returned to the heap. The template is owned by
+ * the process and is never freed here.
  * 
  * @param dfobj The dynamic function object to process
- * @param deep_cleaning true to recursively clean argument names,
+ * @param deep_cleaning true to release the closure,
  *                      false for immediate memory-only cleanup
  */
 static void clear(object_dynamic_function_t *dfobj, bool deep_cleaning) {
-    remove_object_from_list(&dfobj->base.process->objects, &dfobj->base);
+    remove_possible_root((cyclic_object_t *)dfobj);
     if (deep_cleaning) {
-        for (size_t index = 0; index < dfobj->arg_count; index++) {
-            DECREF(dfobj->arg_names[index]);
-        }
         DECREF(dfobj->closure);
     }
-    FREE(dfobj->arg_names);
-    FREE(dfobj);
+    free_slot(dfobj);
 }
 
 /**
@@ -519,8 +511,7 @@ static void clear(object_dynamic_function_t *dfobj, bool deep_cleaning) {
  * @param obj The object whose reference count is to be incremented.
  */
 static void inc_ref(object_t *obj) {
-    object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
-    dfobj->refs++;
+    obj->refs++;
 }
 
 /**
@@ -528,45 +519,39 @@ static void inc_ref(object_t *obj) {
  * @param obj The object whose reference count is to be decremented.
  */
 static void dec_ref(object_t *obj) {
-    object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
-    if (!(--dfobj->refs)) {
-        clear(dfobj, true);
+    if (!(--obj->refs)) {
+        clear((object_dynamic_function_t *)obj, true);
+    } else {
+        add_possible_root((cyclic_object_t *)obj);
     }
 }
 
 /**
- * @brief Marks an object as reachable during garbage collection.
- * @param obj The object to mark as reachable.
+ * @brief Pushes the closure of a dynamic function onto a stack.
+ * @param obj The dynamic function object.
+ * @param stack The stack that receives the closure.
  */
-static void mark(object_t *obj) {
-    object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
-    dfobj->state = MARKED;
+static void push_children(object_t *obj, object_stack_t *stack) {
+    push_object_onto_stack(stack, ((object_dynamic_function_t *)obj)->closure);
 }
 
 /**
- * @brief Sweeps the object (cleaning it up).
- * @param obj The object to sweep.
- * @return true if the object was destroyed,
- *         false if the object was marked (still alive) and shouldn't be processed.
+ * @brief Marks a dynamic function as reachable during garbage collection; its closure is
+ *  pushed onto the work stack of the garbage collector to be marked later.
+ * @param obj The object to mark as reachable.
  */
-static bool sweep(object_t *obj) {
-    object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
-    if (dfobj->state == UNMARKED) {
-        clear(dfobj, false);
-        return true;
-    } else {
-        dfobj->state = UNMARKED;
-        return false;
+static void mark(object_t *obj) {
+    if (mark_slot(obj)) {
+        push_children(obj, get_object_process(obj)->gc_stack);
     }
 }
 
 /**
- * @brief Releases a dynamic function object.
- * @param obj The object to release.
+ * @brief Sweeps the object (destroying it).
+ * @param obj The object to sweep.
  */
-static void release(object_t *obj) {
-    object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
-    clear(dfobj, false);
+static void sweep(object_t *obj) {
+    clear((object_dynamic_function_t *)obj, false);
 }
 
 /**
@@ -587,10 +572,76 @@ static string_value_t dynamic_to_string_notation(const object_t *obj) {
     return dynamic_to_string(obj);
 }
 
+/**
+ * @brief Creates the context of a call of a dynamic function.
+ *
+ * A function whose environment can not escape gets a frame; any other function gets
+ * a context with a data object whose prototype is the closure of the function.
+ *
+ * @param dfobj Pointer to the dynamic function object.
+ * @param caller The calling context.
+ * @param thread Pointer to the thread in which the function is executed.
+ * @return The new context.
+ */
+static context_t *create_call_context(object_dynamic_function_t *dfobj, context_t *caller,
+        thread_t *thread) {
+    const function_template_t *tmpl = dfobj->tmpl;
+    if (tmpl->frame) {
+        return create_frame(caller, dfobj->closure, tmpl->local_count);
+    }
+    return create_context(thread->process, caller, dfobj->closure);
+}
+
+/**
+ * @brief Binds a value to an argument of a dynamic function.
+ * @param ctx The context of the function.
+ * @param tmpl The template of the function.
+ * @param index The index of the argument.
+ * @param value The value; the reference is transferred to the context.
+ */
+static void bind_argument(context_t *ctx, const function_template_t *tmpl, size_t index,
+        object_t *value) {
+    if (!ctx->frame) {
+        create_object_property(ctx->data, tmpl->arg_names[index], value, false);
+        DECREF(value);
+    } else if (index < ctx->local_count) {
+        ctx->locals[index] = value;
+    } else {
+        DECREF(value);
+    }
+}
+
+/**
+ * @brief Binds the arguments of a call to the parameters of a dynamic function.
+ *
+ * Pops the arguments from the data stack and stores them in the context of the function:
+ * as properties of the data object, or in the first slots of a frame. Missing arguments are
+ * bound to `null`; extra arguments are left on the stack.
+ *
+ * @param dfobj Pointer to the dynamic function object.
+ * @param ctx The context of the function.
+ * @param arg_count The number of arguments passed to the function.
+ * @param thread Pointer to the thread in which the function is executed.
+ */
+static void bind_arguments(object_dynamic_function_t *dfobj, context_t *ctx,
+        uint16_t arg_count, thread_t *thread) {
+    const function_template_t *tmpl = dfobj->tmpl;
+    uint16_t index;
+    for (index = 0; index < arg_count && index < tmpl->arg_count; index++) {
+        bind_argument(ctx, tmpl, index, pop_object_from_stack(thread->data_stack));
+    }
+    for (; index < tmpl->arg_count; index++) {
+        bind_argument(ctx, tmpl, index, get_null_object());
+    }
+}
+
 /**
  * @brief Executes a dynamic function object.
  *
- * This function is the implementation of the `call` method for dynamic function objects...
+ * This function is the implementation of the `call` method for dynamic function objects.
+ * It creates a new context (a frame, or a context whose prototype is the closure of
+ * the function), binds the arguments, pushes a placeholder for the return value and jumps
+ * to the function body.
  *
  * @param obj Pointer to the dynamic function object.
  * @param arg_count The number of arguments passed to the function.
@@ -599,22 +650,14 @@ static string_value_t dynamic_to_string_notation(const object_t *obj) {
  */
 static bool dynamic_call(object_t *obj, uint16_t arg_count, thread_t *thread) {
     object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
-    context_t *ctx = create_context(thread->process, thread->context, dfobj->closure);
+    context_t *ctx = create_call_context(dfobj, thread->context, thread);
     ctx->ret_address = thread->instr_id + 1;
-    uint16_t index;
-    for (index = 0; index < arg_count && index < dfobj->arg_count; index++) {
-        object_t *arg = pop_object_from_stack(thread->data_stack);
-        create_object_property(ctx->data, dfobj->arg_names[index], arg, false);
-        DECREF(arg);
-    }
-    for (; index < dfobj->arg_count; index++) {
-        create_object_property(ctx->data, dfobj->arg_names[index], get_null_object(), false);
-    }
+    bind_arguments(dfobj, ctx, arg_count, thread);
     stack_index_t ret_value_index = push_object_onto_stack(thread->data_stack, get_null_object());
     ctx->ret_value_index = ret_value_index;
     ctx->unwinding_index = ret_value_index;
     thread->context = ctx;
-    thread->instr_id = dfobj->first_instr_id;
+    thread->instr_id = dfobj->tmpl->first_instr_id;
     return true;
 }
 
@@ -628,7 +671,8 @@ static object_vtbl_t dynamic_vtbl = {
     .dec_ref = dec_ref,
     .mark = mark,
     .sweep = sweep,
-    .release = release,
+    .push_children = push_children,
+    .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
     .to_string = dynamic_to_string,
@@ -639,6 +683,8 @@ static object_vtbl_t dynamic_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -657,22 +703,41 @@ static object_vtbl_t dynamic_vtbl = {
     .call = dynamic_call
 };
 
-object_t *create_function_object(process_t *process, object_t **arg_names, size_t arg_count,
-        instr_index_t first_instr_id, object_t *closure) {
-    object_dynamic_function_t *obj = (object_dynamic_function_t *)CALLOC(
-        sizeof(object_dynamic_function_t));
-    obj->base.vtbl = &dynamic_vtbl;
-    obj->base.process = process;
-    obj->refs = 1;
-    obj->state = UNMARKED;
-    obj->arg_names = arg_names;
-    obj->arg_count = arg_count;
-    for (size_t index = 0; index < arg_count; index++) {
-        INCREF(arg_names[index]);
-    }
-    obj->first_instr_id = first_instr_id;
+object_t *create_function_object(process_t *process, const function_template_t *tmpl,
+        object_t *closure) {
+    object_dynamic_function_t *obj = (object_dynamic_function_t *)allocate_object(
+        &process->heap, &dynamic_vtbl, sizeof(object_dynamic_function_t));
+    obj->root_index = 0;
+    obj->tmpl = tmpl;
     obj->closure = closure;
     INCREF(closure);
-    add_object_to_list(&process->objects, &obj->base);
     return &obj->base;
 }
+
+bool call_function_with_template(object_t *obj, const function_template_t *tmpl,
+        uint16_t arg_count, thread_t *thread) {
+    if (get_object_vtbl(obj) != &dynamic_vtbl
+            || ((object_dynamic_function_t *)obj)->tmpl != tmpl) {
+        return call_object(obj, arg_count, thread);
+    }
+    return dynamic_call(obj, arg_count, thread);
+}
+
+bool tail_call_object(object_t *obj, uint16_t arg_count, thread_t *thread) {
+    context_t *ctx = thread->context;
+    if (get_object_vtbl(obj) != &dynamic_vtbl || ctx->ret_address == BAD_INSTR_INDEX
+            || ctx->unwinding_index == BAD_STACK_INDEX) {
+        return call_object(obj, arg_count, thread);
+    }
+    object_dynamic_function_t *dfobj = (object_dynamic_function_t *)obj;
+    context_t *callee = create_call_context(dfobj, ctx->previous, thread);
+    callee->ret_address = ctx->ret_address;
+    callee->ret_value_index = ctx->ret_value_index;
+    callee->unwinding_index = ctx->unwinding_index;
+    bind_arguments(dfobj, callee, arg_count, thread);
+    reduce_object_stack(thread->data_stack, ctx->unwinding_index);
+    destroy_context(ctx);
+    thread->context = callee;
+    thread->instr_id = dfobj->tmpl->first_instr_id;
+    return true;
+}
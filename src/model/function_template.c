@@ -0,0 +1,33 @@
+/**
+ * @file function_template.c
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Implementation of templates of user-defined functions.
+ */
+
+#include "function_template.h"
+#include "process.h"
+#include "lib/allocate.h"
+
+function_template_t *create_function_template(process_t *process, object_t **arg_names,
+        size_t arg_count, instr_index_t first_instr_id, instr_index_t site, bool frame,
+        size_t local_count) {
+    function_template_t *tmpl = (function_template_t *)ALLOC(sizeof(function_template_t));
+    tmpl->arg_names = arg_names;
+    tmpl->arg_count = arg_count;
+    tmpl->first_instr_id = first_instr_id;
+    tmpl->site = site;
+    tmpl->frame = frame;
+    tmpl->local_count = local_count;
+    tmpl->next = process->function_templates;
+    process->function_templates = tmpl;
+    return tmpl;
+}
+
+void destroy_function_templates(function_template_t *list) {
+    while (list) {
+        function_template_t *next = list->next;
+        FREE(list->arg_names);
+        FREE(list);
+        list = next;
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file function_template.h
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Templates of user-defined functions.
+ *
+ * Everything a user-defined function knows about itself, except its closure, is fixed by
+ * the bytecode: the entry point and the names of the arguments. A template holding this
+ * information is created once for each `FUNC` instruction and shared by all function objects
+ * created there, so creating a closure does not copy anything but two pointers.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common/types.h"
+
+/**
+ * @typedef object_t
+ * @brief Forward declaration for the object structure.
+ */
+typedef struct object_t object_t;
+
+/**
+ * @typedef process_t
+ * @brief Forward declaration for the process structure.
+ */
+typedef struct process_t process_t;
+
+/**
+ * @typedef function_template_t
+ * @brief Forward declaration for the function template structure.
+ */
+typedef struct function_template_t function_template_t;
+
+/**
+ * @struct function_template_t
+ * @brief Immutable description of a user-defined function.
+ */
+struct function_template_t {
+    /**
+     * @brief The next template of the same process.
+     */
+    function_template_t *next;
+
+    /**
+     * @brief Names of the arguments.
+     *
+     * The names are interned strings; they live as long as the process, so the template does
+     * not hold references to them.
+     */
+    object_t **arg_names;
+
+    /**
+     * @brief The number of arguments the function accepts.
+     */
+    size_t arg_count;
+
+    /**
+     * @brief The index of the first instruction of the function body.
+     */
+    instr_index_t first_instr_id;
+
+    /**
+     * @brief Whether the function is executed in a frame (its environment can not escape).
+     */
+    bool frame;
+
+    /**
+     * @brief The number of local variable slots of the frame, the arguments included.
+     */
+    size_t local_count;
+
+    /**
+     * @brief The index of the `FUNC` instruction that creates the function, used to tell
+     *  functions apart while debugging.
+     */
+    instr_index_t site;
+};
+
+/**
+ * @brief Creates a function template owned by a process.
+ *
+ * The argument names array must be allocated by the caller; ownership is transferred to
+ * the template. The template is destroyed together with the process.
+ *
+ * @param process The process that owns the template.
+ * @param arg_names Array of interned argument names. Ownership is transferred.
+ * @param arg_count Number of arguments the function accepts.
+ * @param first_instr_id Index of the first instruction of the function body.
+ * @param site Index of the instruction that creates the function.
+ * @param frame Whether the function is executed in a frame.
+ * @param local_count The number of local variable slots of the frame.
+ * @return A pointer to the new template.
+ */
+function_template_t *create_function_template(process_t *process, object_t **arg_names,
+        size_t arg_count, instr_index_t first_instr_id, instr_index_t site, bool frame,
+        size_t local_count);
+
+/**
+ * @brief Destroys a list of function templates.
+ * @param list The first template of the list, can be `NULL`.
+ */
+void destroy_function_templates(function_template_t *list);
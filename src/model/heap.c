@@ -0,0 +1,186 @@
+/**
+ * @file heap.c
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Implements the heap that holds the objects of a process.
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "heap.h"
+#include "object.h"
+#include "lib/allocate.h"
+
+static_assert(offsetof(slab_t, slots) % SIZE_CLASS_STEP == 0,
+    "Slots must be aligned to the step of the size classes");
+
+static_assert((SLAB_SIZE - offsetof(slab_t, slots)) / SIZE_CLASS_STEP <= SLAB_BITMAP_WORDS * 64,
+    "The bitmaps of a slab must have a bit for every slot");
+
+void init_heap(heap_t *heap, process_t *process) {
+    heap->process = process;
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; index++) {
+        heap->classes[index].slot_size = (index + 1) * SIZE_CLASS_STEP;
+        heap->classes[index].slabs = NULL;
+        heap->classes[index].free_list = NULL;
+    }
+    heap->spare_slabs = NULL;
+    heap->chunks = create_vector();
+    heap->object_count = 0;
+}
+
+/**
+ * @brief Takes a spare slab, allocating a new chunk of slabs if there are none.
+ * @param heap The heap.
+ * @return The slab; its header is not initialized.
+ */
+static slab_t *take_spare_slab(heap_t *heap) {
+    if (heap->spare_slabs == NULL) {
+        uint8_t *chunk = (uint8_t *)ALLOC(SLAB_SIZE * (SLABS_PER_CHUNK + 1));
+        append_to_vector(heap->chunks, chunk);
+        uintptr_t first = ((uintptr_t)chunk + SLAB_SIZE - 1) & ~(uintptr_t)(SLAB_SIZE - 1);
+        for (size_t index = SLABS_PER_CHUNK; index > 0; index--) {
+            slab_t *slab = (slab_t *)(first + (index - 1) * SLAB_SIZE);
+            slab->next = heap->spare_slabs;
+            heap->spare_slabs = slab;
+        }
+    }
+    slab_t *slab = heap->spare_slabs;
+    heap->spare_slabs = slab->next;
+    return slab;
+}
+
+/**
+ * @brief Adds a slab to a size class and puts all its slots into the free list of the class.
+ * @param heap The heap.
+ * @param size_class The size class.
+ */
+static void add_slab(heap_t *heap, size_class_t *size_class) {
+    slab_t *slab = take_spare_slab(heap);
+    slab->heap = heap;
+    slab->process = heap->process;
+    slab->slot_size = (uint32_t)size_class->slot_size;
+    slab->capacity = (uint32_t)((SLAB_SIZE - offsetof(slab_t, slots)) / slab->slot_size);
+    memset(slab->allocated, 0, sizeof(slab->allocated));
+    memset(slab->marked, 0, sizeof(slab->marked));
+    slab->next = size_class->slabs;
+    size_class->slabs = slab;
+    for (size_t index = slab->capacity; index > 0; index--) {
+        void **slot = (void **)(slab->slots + (index - 1) * slab->slot_size);
+        *slot = size_class->free_list;
+        size_class->free_list = slot;
+    }
+}
+
+void *allocate_slot(heap_t *heap, size_t size) {
+    assert(size > 0 && size <= SIZE_CLASS_COUNT * SIZE_CLASS_STEP);
+    size_class_t *size_class = &heap->classes[(size - 1) / SIZE_CLASS_STEP];
+    if (size_class->free_list == NULL) {
+        add_slab(heap, size_class);
+    }
+    void **slot = (void **)size_class->free_list;
+    size_class->free_list = *slot;
+    slab_t *slab = get_slab(slot);
+    size_t index = (size_t)((uint8_t *)slot - slab->slots) / slab->slot_size;
+    slab->allocated[index / 64] |= (uint64_t)1 << (index % 64);
+    heap->object_count++;
+    return slot;
+}
+
+void free_slot(void *ptr) {
+    slab_t *slab = get_slab(ptr);
+    size_class_t *size_class = &slab->heap->classes[slab->slot_size / SIZE_CLASS_STEP - 1];
+    size_t index = (size_t)((uint8_t *)ptr - slab->slots) / slab->slot_size;
+    assert(slab->allocated[index / 64] & ((uint64_t)1 << (index % 64)));
+    slab->allocated[index / 64] &= ~((uint64_t)1 << (index % 64));
+    *(void **)ptr = size_class->free_list;
+    size_class->free_list = ptr;
+    slab->heap->object_count--;
+}
+
+/**
+ * @brief Sweeps the unmarked objects of a slab and clears its marks.
+ * @param slab The slab.
+ */
+static void sweep_slab(slab_t *slab) {
+    for (size_t word = 0; word < SLAB_BITMAP_WORDS; word++) {
+        uint64_t garbage = slab->allocated[word] & ~slab->marked[word];
+        for (size_t bit = 0; garbage != 0; bit++, garbage >>= 1) {
+            if (garbage & 1) {
+                sweep_object((object_t *)(slab->slots + (word * 64 + bit) * slab->slot_size));
+            }
+        }
+        slab->marked[word] = 0;
+    }
+}
+
+/**
+ * @brief Checks whether a slab has no allocated slots.
+ * @param slab The slab.
+ * @return `true` if the slab is empty.
+ */
+static bool is_slab_empty(const slab_t *slab) {
+    for (size_t word = 0; word < SLAB_BITMAP_WORDS; word++) {
+        if (slab->allocated[word] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rebuilds the free list of a size class from the bitmaps of its slabs, moving
+ *  empty slabs to the spare slabs of the heap.
+ * @param heap The heap.
+ * @param size_class The size class.
+ */
+static void rebuild_free_list(heap_t *heap, size_class_t *size_class) {
+    void **tail = &size_class->free_list;
+    slab_t **link = &size_class->slabs;
+    while (*link != NULL) {
+        slab_t *slab = *link;
+        if (is_slab_empty(slab)) {
+            *link = slab->next;
+            slab->next = heap->spare_slabs;
+            heap->spare_slabs = slab;
+            continue;
+        }
+        for (size_t index = 0; index < slab->capacity; index++) {
+            if (!(slab->allocated[index / 64] & ((uint64_t)1 << (index % 64)))) {
+                void **slot = (void **)(slab->slots + index * slab->slot_size);
+                *tail = slot;
+                tail = slot;
+            }
+        }
+        link = &slab->next;
+    }
+    *tail = NULL;
+}
+
+void sweep_heap(heap_t *heap) {
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; index++) {
+        for (slab_t *slab = heap->classes[index].slabs; slab != NULL; slab = slab->next) {
+            sweep_slab(slab);
+        }
+    }
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; index++) {
+        rebuild_free_list(heap, &heap->classes[index]);
+    }
+}
+
+void destroy_heap(heap_t *heap) {
+    for (size_t index = 0; index < SIZE_CLASS_COUNT; index++) {
+        for (slab_t *slab = heap->classes[index].slabs; slab != NULL; slab = slab->next) {
+            for (size_t slot = 0; slot < slab->capacity; slot++) {
+                if (slab->allocated[slot / 64] & ((uint64_t)1 << (slot % 64))) {
+                    release_object((object_t *)(slab->slots + slot * slab->slot_size));
+                }
+            }
+        }
+    }
+    for (size_t index = 0; index < heap->chunks->size; index++) {
+        FREE(heap->chunks->data[index]);
+    }
+    destroy_vector(heap->chunks);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file heap.h
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Defines the heap that holds the objects of a process.
+ *
+ * Objects are not allocated one by one. The heap of a process carves fixed-size slabs out of
+ * large chunks of memory; each slab belongs to a size class and is divided into slots of
+ * the same size. Which slots are allocated and which objects have been reached by the garbage
+ * collector is kept in bitmaps in the header of the slab, not in the objects themselves, so
+ * the sweep walks the bitmaps word by word. Slabs are aligned to their size, so the slab of
+ * an object is found by masking the address of the object; the header of the slab points to
+ * the process owning the object, so objects do not have to store it.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/vector.h"
+
+/**
+ * @def SLAB_SIZE
+ * @brief The size of a slab in bytes; it must be a power of two.
+ */
+#define SLAB_SIZE 16384
+
+/**
+ * @def SLABS_PER_CHUNK
+ * @brief The number of slabs carved out of one chunk of memory.
+ */
+#define SLABS_PER_CHUNK 16
+
+/**
+ * @def SIZE_CLASS_STEP
+ * @brief The difference between the slot sizes of neighboring size classes, in bytes.
+ */
+#define SIZE_CLASS_STEP 8
+
+/**
+ * @def SIZE_CLASS_COUNT
+ * @brief The number of size classes; objects may not be larger than
+ *  `SIZE_CLASS_COUNT * SIZE_CLASS_STEP` bytes.
+ */
+#define SIZE_CLASS_COUNT 32
+
+/**
+ * @def SLAB_BITMAP_WORDS
+ * @brief The number of 64-bit words in each bitmap of a slab.
+ */
+#define SLAB_BITMAP_WORDS (SLAB_SIZE / SIZE_CLASS_STEP / 64)
+
+/**
+ * @typedef process_t
+ * @brief Forward declaration for the process structure.
+ */
+typedef struct process_t process_t;
+
+/**
+ * @typedef slab_t
+ * @brief Forward declaration for the slab structure.
+ */
+typedef struct slab_t slab_t;
+
+/**
+ * @typedef heap_t
+ * @brief Forward declaration for the heap structure.
+ */
+typedef struct heap_t heap_t;
+
+/**
+ * @struct size_class_t
+ * @brief Slabs holding objects of the same size.
+ */
+typedef struct {
+    /**
+     * @brief The size of a slot in bytes.
+     */
+    size_t slot_size;
+
+    /**
+     * @brief The slabs of the size class.
+     */
+    slab_t *slabs;
+
+    /**
+     * @brief The list of free slots; each free slot holds a pointer to the next one.
+     */
+    void *free_list;
+} size_class_t;
+
+/**
+ * @struct slab_t
+ * @brief A block of memory divided into slots of the same size.
+ */
+struct slab_t {
+    /**
+     * @brief The next slab of the same size class, or the next spare slab.
+     */
+    slab_t *next;
+
+    /**
+     * @brief The heap the slab belongs to.
+     */
+    heap_t *heap;
+
+    /**
+     * @brief The process owning the objects of the slab.
+     */
+    process_t *process;
+
+    /**
+     * @brief The size of a slot in bytes.
+     */
+    uint32_t slot_size;
+
+    /**
+     * @brief The number of slots in the slab.
+     */
+    uint32_t capacity;
+
+    /**
+     * @brief Bitmap of the allocated slots.
+     */
+    uint64_t allocated[SLAB_BITMAP_WORDS];
+
+    /**
+     * @brief Bitmap of the objects marked by the garbage collector; it is cleared by the sweep.
+     */
+    uint64_t marked[SLAB_BITMAP_WORDS];
+
+    /**
+     * @brief The slots.
+     */
+    uint8_t slots[];
+};
+
+/**
+ * @struct heap_t
+ * @brief The heap of a process.
+ */
+struct heap_t {
+    /**
+     * @brief The process owning the heap.
+     */
+    process_t *process;
+
+    /**
+     * @brief Size classes; the slots of the class with index `i` are
+     *  `(i + 1) * SIZE_CLASS_STEP` bytes long.
+     */
+    size_class_t classes[SIZE_CLASS_COUNT];
+
+    /**
+     * @brief Slabs that are not used by any size class.
+     */
+    slab_t *spare_slabs;
+
+    /**
+     * @brief Chunks of memory the slabs are carved out of, as they were allocated.
+     */
+    vector_t *chunks;
+
+    /**
+     * @brief The number of allocated slots, that is, the number of live objects.
+     */
+    size_t object_count;
+};
+
+/**
+ * @brief Initializes an empty heap.
+ * @param heap The heap.
+ * @param process The process owning the heap.
+ */
+void init_heap(heap_t *heap, process_t *process);
+
+/**
+ * @brief Allocates a slot for an object.
+ * @param heap The heap.
+ * @param size The size of the object in bytes.
+ * @return A pointer to the slot; its content is undefined.
+ */
+void *allocate_slot(heap_t *heap, size_t size);
+
+/**
+ * @brief Returns the slot of a destroyed object to the heap it was allocated from.
+ * @param ptr A pointer to the slot.
+ */
+void free_slot(void *ptr);
+
+/**
+ * @brief Returns the slab containing an allocated slot.
+ * @param ptr A pointer to the slot.
+ * @return The slab.
+ */
+static inline slab_t *get_slab(const void *ptr) {
+    return (slab_t *)((uintptr_t)ptr & ~(uintptr_t)(SLAB_SIZE - 1));
+}
+
+/**
+ * @brief Sets the mark bit of the object stored in a slot.
+ * @param ptr A pointer to the slot.
+ * @return `true` if the object has just been marked, `false` if it was already marked.
+ */
+static inline bool mark_slot(const void *ptr) {
+    slab_t *slab = get_slab(ptr);
+    size_t index = (size_t)((const uint8_t *)ptr - slab->slots) / slab->slot_size;
+    uint64_t *word = &slab->marked[index / 64];
+    uint64_t bit = (uint64_t)1 << (index % 64);
+    if (*word & bit) {
+        return false;
+    }
+    *word |= bit;
+    return true;
+}
+
+/**
+ * @brief Destroys all allocated objects that are not marked, and clears the marks.
+ *
+ * Each unmarked object is swept (see `sweep_object`), which destroys it without decrementing
+ * the reference counts of its children, since they are either swept too or still alive.
+ * Slabs left empty become spare and can be given to any size class.
+ *
+ * @param heap The heap.
+ */
+void sweep_heap(heap_t *heap);
+
+/**
+ * @brief Releases all objects that are still allocated and frees the memory of the heap.
+ * @param heap The heap.
+ */
+void destroy_heap(heap_t *heap);
@@ -5,10 +5,13 @@
  *
  * This file defines the structure and behavior of integer objects. There are two types
  * of integer objects:
- * 1. Static integers:
- *    - These include integers declared in the model.
+ * 1. Tagged integers:
+ *    - These are integers that fit into a pointer with one bit reserved for the tag
+ *      (63 bits on 64-bit platforms), which is all integers in practice.
+ *    - The value is stored in the pointer itself, so they are neither allocated nor
+ *      reference counted.
  * 2. Dynamic integers:
- *    - These are created as a result of operations at runtime.
+ *    - These hold values that do not fit into a tagged pointer.
  *    - They internally store their own value and are subject to garbage collection when
  *      no longer in use.
  */
@@ -19,39 +22,17 @@
 #include <math.h>
 
 #include "object.h"
-#include "object_state.h"
 #include "process.h"
 #include "common_methods.h"
 #include "lib/allocate.h"
 #include "lib/string_ext.h"
 
-/**
- * @def POOL_CAPACITY
- * @brief Defines the maximum capacity of the object pool.
- * 
- * This macro sets the maximum number of objects that can be stored in the object pool 
- * before it reaches its capacity. Once the pool is full, any swept objects are destroyed 
- * instead of being added to the pool.
- */
-#define POOL_CAPACITY 1024
-
-/**
- * @struct object_static_integer_t
- * @brief Structure representing a static integer object.
- */
-typedef struct {
-    object_t base; ///< The base object that provides common functionality.
-    int64_t value; ///< The integer value of the object.
-} object_static_integer_t;
-
 /**
  * @struct object_dynamic_integer_t
  * @brief Structure representing a dynamic integer object.
  */
 typedef struct {
     object_t base; ///< The base object that provides common functionality.
-    int refs; ///< Reference count.
-    object_state_t state; ///< The state of the object (e.g., unmarked, marked, or zombie).
     int64_t value; ///< The integer value of the object.
 } object_dynamic_integer_t;
 
@@ -132,7 +113,7 @@ static object_vtbl_t integer_proto_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -144,6 +125,8 @@ static object_vtbl_t integer_proto_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -177,34 +160,12 @@ object_t *get_integer_proto() {
     return &integer_proto;
 }
 
-/**
- * @brief Releases or clears a dynamic integer object.
- * 
- * This function either frees the object or resets its state and moves it to a list of reusable
- * objects, depending on the number of objects in the pool.
- * 
- * @param diobj The dynamic integer object to release or clear.
- */
-static void release_or_clear(object_dynamic_integer_t *diobj) {
-    remove_object_from_list(&diobj->base.process->objects, &diobj->base);
-    if (diobj->base.process->integers.size == POOL_CAPACITY) {
-        FREE(diobj);
-    } else {
-        diobj->refs = 0;
-        diobj->state = ZOMBIE;
-        diobj->value = 0;
-        add_object_to_list(&diobj->base.process->integers, &diobj->base);
-    }
-}
-
 /**
  * @brief Increments the reference count of an object.
  * @param obj The object whose reference count is to be incremented.
  */
 static void inc_ref(object_t *obj) {
-    object_dynamic_integer_t *diobj = (object_dynamic_integer_t *)obj;
-    assert(diobj->state != ZOMBIE);
-    diobj->refs++;
+    obj->refs++;
 }
 
 /**
@@ -212,10 +173,8 @@ static void inc_ref(object_t *obj) {
  * @param obj The object whose reference count is to be decremented.
  */
 static void dec_ref(object_t *obj) {
-    object_dynamic_integer_t *diobj = (object_dynamic_integer_t *)obj;
-    assert(diobj->state != ZOMBIE);
-    if (!(--diobj->refs)) {
-        release_or_clear(diobj);
+    if (!(--obj->refs)) {
+        free_slot(obj);
     }
 }
 
@@ -224,39 +183,15 @@ static void dec_ref(object_t *obj) {
  * @param obj The object to mark as reachable.
  */
 static void mark(object_t *obj) {
-    object_dynamic_integer_t *diobj = (object_dynamic_integer_t *)obj;
-    assert(diobj->state != ZOMBIE);
-    diobj->state = MARKED;
+    mark_slot(obj);
 }
 
 /**
- * @brief Sweeps the object, cleaning it up or moving it to the object pool.
+ * @brief Sweeps the object, returning its slot to the heap.
  * @param obj The object to sweep.
- * @return true if the object was either destroyed or moved to object pool (ZOMBIE),
- *         false if the object was marked (still alive) and shouldn't be processed.
- */
-static bool sweep(object_t *obj) {
-    object_dynamic_integer_t *diobj = (object_dynamic_integer_t *)obj;
-    assert(diobj->state != ZOMBIE);
-    if (diobj->state == UNMARKED) {
-        release_or_clear(diobj);
-        return true;
-    } else {
-        diobj->state = UNMARKED;
-        return false;
-    }
-}
-
-/**
- * @brief Releases an integer object.
- * @param obj The object to release.
  */
-static void release(object_t *obj) {
-    object_dynamic_integer_t *diobj = (object_dynamic_integer_t *)obj;
-    remove_object_from_list(
-        diobj->state == ZOMBIE ? &obj->process->integers : &obj->process->objects, obj
-    );
-    FREE(obj);
+static void sweep(object_t *obj) {
+    free_slot(obj);
 }
 
 /**
@@ -285,7 +220,7 @@ static int compare(const object_t *obj1, const object_t *obj2) {
  *  is returned; otherwise, a new object is created.
  */
 static object_t *clone(process_t *process, object_t *obj) {
-    if (process == obj->process) {
+    if (process == get_object_process(obj)) {
         return obj;
     }
     return create_integer_object(process, get_object_integer_value(obj).value);
@@ -505,13 +440,12 @@ static bool get_boolean_value(const object_t *obj) {
 }
 
 /**
- * @brief Retrieves the integer value of a static object.
+ * @brief Retrieves the integer value of a tagged integer.
  * @param obj The object from which to retrieve the integer value.
  * @return An `int_value_t` structure containing the integer value.
  */
-static int_value_t static_get_integer_value(const object_t *obj) {
-    object_static_integer_t *siobj = (object_static_integer_t *)obj;
-    return (int_value_t){ true, siobj->value };
+static int_value_t tagged_get_integer_value(const object_t *obj) {
+    return (int_value_t){ true, get_tagged_integer_value(obj) };
 }
 
 /**
@@ -525,13 +459,12 @@ static int_value_t dynamic_get_integer_value(const object_t *obj) {
 }
 
 /**
- * @brief Retrieves value of a static object casted to real.
+ * @brief Retrieves value of a tagged integer casted to real.
  * @param obj The object from which to retrieve the real value.
  * @return A `real_value_t` structure containing the real value.
  */
-static real_value_t static_get_real_value(const object_t *obj) {
-    object_static_integer_t *siobj = (object_static_integer_t *)obj;
-    return (real_value_t){ true, (double)siobj->value };
+static real_value_t tagged_get_real_value(const object_t *obj) {
+    return (real_value_t){ true, (double)get_tagged_integer_value(obj) };
 }
 
 /**
@@ -545,18 +478,18 @@ static real_value_t dynamic_get_real_value(const object_t *obj) {
 }
 
 /**
- * @var static_vtbl
- * @brief This virtual table defines the behavior of the static integer object.
+ * @var tagged_integer_vtbl
+ * @brief This virtual table defines the behavior of tagged integers.
  */
-static object_vtbl_t static_vtbl = {
+object_vtbl_t tagged_integer_vtbl = {
     .type = TYPE_NUMBER,
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare,
-    .clone = clone,
+    .clone = clone_singleton,
     .to_string = to_string,
     .to_string_notation = to_string_notation,
     .get_prototypes = get_prototypes,
@@ -565,6 +498,8 @@ static object_vtbl_t static_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = add,
     .subtract = subtract,
     .multiply = multiply,
@@ -578,52 +513,13 @@ static object_vtbl_t static_vtbl = {
     .equal = common_equal,
     .not_equal = common_not_equal,
     .get_boolean_value = get_boolean_value,
-    .get_integer_value = static_get_integer_value,
-    .get_real_value = static_get_real_value,
+    .get_integer_value = tagged_get_integer_value,
+    .get_real_value = tagged_get_real_value,
     .call = stub_call
 };
 
-/**
- * @brief The total number of static integer objects.
- */
-#define STATIC_INTEGER_RANGE (MAX_STATIC_INTEGER - MIN_STATIC_INTEGER + 1)
-
-/**
- * @brief Static array of objects representing static integer values.
- * 
- * This array holds objects corresponding to integers in the range defined by
- * `MIN_STATIC_INTEGER` to `MAX_STATIC_INTEGER`.
- */
-static object_static_integer_t static_integers[STATIC_INTEGER_RANGE];
-
-/**
- * @brief Flag to indicate whether the static integers array has been initialized.
- */
-static bool is_static_integers_initialized = false;
-
-/**
- * @brief Initializes the static integer objects array.
- * 
- * This function initializes the static array of integer objects for the range
- * `MIN_STATIC_INTEGER` to `MAX_STATIC_INTEGER`. It is automatically invoked during the
- * first call to `get_static_integer_object()`.
- */
-static void initialize_static_integers() {
-    for (int i = MIN_STATIC_INTEGER; i <= MAX_STATIC_INTEGER; ++i) {
-        static_integers[i - MIN_STATIC_INTEGER] = (object_static_integer_t){
-            { &static_vtbl, NULL, NULL, NULL },
-            i
-        };
-    }
-    is_static_integers_initialized = true;
-}
-
 object_t *get_static_integer_object(int value) {
-    assert(value >= MIN_STATIC_INTEGER && value <= MAX_STATIC_INTEGER);
-    if (!is_static_integers_initialized) {
-        initialize_static_integers();
-    }
-    return &static_integers[value - MIN_STATIC_INTEGER].base;
+    return make_tagged_integer(value);
 }
 
 object_t *get_integer_zero() {
@@ -640,7 +536,7 @@ static object_vtbl_t dynamic_vtbl = {
     .dec_ref = dec_ref,
     .mark = mark,
     .sweep = sweep,
-    .release = release,
+    .release = stub_memory_function,
     .compare = compare,
     .clone = clone,
     .to_string = to_string,
@@ -651,6 +547,8 @@ static object_vtbl_t dynamic_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = add,
     .subtract = subtract,
     .multiply = multiply,
@@ -670,20 +568,11 @@ static object_vtbl_t dynamic_vtbl = {
 };
 
 object_t *create_integer_object(process_t *process, int64_t value) {
-    if (value >= MIN_STATIC_INTEGER && value <= MAX_STATIC_INTEGER) {
-        return get_static_integer_object((int)value);
-    }
-    object_dynamic_integer_t *obj;
-    if (process->integers.size > 0) {
-        obj = (object_dynamic_integer_t *)remove_first_object_from_list(&process->integers);
-    } else {
-        obj = (object_dynamic_integer_t *)CALLOC(sizeof(object_dynamic_integer_t));
-        obj->base.vtbl = &dynamic_vtbl;
-        obj->base.process = process;
+    if (value >= TAGGED_INTEGER_MIN && value <= TAGGED_INTEGER_MAX) {
+        return make_tagged_integer(value);
     }
-    obj->refs = 1;
-    obj->state = UNMARKED;
+    object_dynamic_integer_t *obj = (object_dynamic_integer_t *)allocate_object(&process->heap,
+        &dynamic_vtbl, sizeof(object_dynamic_integer_t));
     obj->value = value;
-    add_object_to_list(&process->objects, &obj->base);
     return &obj->base;
 }
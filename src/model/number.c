@@ -47,7 +47,7 @@ static object_vtbl_t numeric_proto_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -59,6 +59,8 @@ static object_vtbl_t numeric_proto_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
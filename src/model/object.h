@@ -11,8 +11,15 @@
 
 #pragma once
 
+#include <assert.h>
+#include <stdint.h>
+
 #include "common/types.h"
 #include "model_status.h"
+#include "object_state.h"
+#include "heap.h"
+#include "object_stack.h"
+#include "lib/avl_tree.h"
 #include "lib/value.h"
 
 /**
@@ -33,6 +40,12 @@ typedef struct process_t process_t;
  */
 typedef struct thread_t thread_t;
 
+/**
+ * @typedef function_template_t
+ * @brief Forward declaration for the function template structure.
+ */
+typedef struct function_template_t function_template_t;
+
 /**
  * @enum object_type_t
  * @brief Enumeration of object types in the Goat virtual machine.
@@ -148,26 +161,41 @@ typedef struct {
      * @brief Function pointer for marking an object during garbage collection.
      * 
      * The `mark` function is used during the garbage collection process to identify
-     * objects that are still in use. This function typically sets a flag or performs
-     * some other operation to indicate that the object is reachable from the root set
-     * or another marked object.
+     * objects that are still in use. Objects allocated in the heap of a process set their
+     * bit in the mark bitmap of their slab; objects that are not allocated there (static
+     * objects) do nothing.
      * 
      * @param obj The object to mark.
      */
     void (*mark)(object_t *obj);
 
     /**
-     * @brief Function pointer for sweeping (cleaning up) an object during garbage collection.
+     * @brief Function pointer for sweeping (destroying) an unreachable object during garbage
+     *  collection.
      * 
-     * The `sweep` function is responsible for cleaning up objects that are no longer
-     * marked as in use. This includes either complete destruction or preparing the object
-     * for reuse (moving to object pool and marking as ZOMBIE).
+     * The `sweep` function destroys an object that the garbage collector has found
+     * unreachable and returns its slot to the heap. The reference counts of its children
+     * are not decremented: the children are either unreachable too and swept as well,
+     * or they are alive and hold the reference anyway.
      * 
      * @param obj The object to sweep.
-     * @return true if the object was either destroyed or moved to object pool (ZOMBIE),
-     *         false if the object was marked (still alive) and shouldn't be processed.
      */
-    bool (*sweep)(object_t *obj);
+    void (*sweep)(object_t *obj);
+
+    /**
+     * @brief Function pointer for enumerating the objects this object holds references to.
+     * 
+     * Pushes every child of the object onto the given stack (tagged integers and static
+     * objects included), so that the garbage collectors can walk the object graph with
+     * an explicit stack instead of recursion. Only objects that can refer to other objects,
+     * and thus be part of a reference cycle, have this function; it is `NULL` for all other
+     * types. Every reference pushed is counted in the reference count of the child. An object
+     * that has this function begins with the `cyclic_object_t` structure.
+     * 
+     * @param obj The object whose children are enumerated.
+     * @param stack The stack that receives the children.
+     */
+    void (*push_children)(object_t *obj, object_stack_t *stack);
     
     /**
      * @brief Function pointer for releasing (destroying) an object.
@@ -329,6 +357,39 @@ typedef struct {
      */
     model_status_t (*set_property)(object_t *obj, object_t *key, object_t *value);
 
+    /**
+     * @brief Retrieves the value of a property by its index.
+     * 
+     * Properties of objects that support indexed access are numbered in the order
+     * of their creation. The key is used as a guard: the function succeeds only if the property
+     * stored under the given index has exactly this key (the same object), so a caller that
+     * predicted the index statically can fall back to the lookup by key if the prediction
+     * turned out to be wrong.
+     * 
+     * @param obj The object from which to retrieve the property.
+     * @param index The index of the property.
+     * @param key The expected key of the property.
+     * @return A pointer to the value of the property, or NULL if there is no property with
+     *  this key under this index.
+     */
+    object_t* (*get_property_by_index)(const object_t *obj, size_t index, const object_t *key);
+
+    /**
+     * @brief Sets a property on an object by its index.
+     * 
+     * Works like `set_property`, but addresses the property by its index, guarded by the key
+     * in the same way as `get_property_by_index`.
+     * 
+     * @param obj The object on which to set the property.
+     * @param index The index of the property.
+     * @param key The expected key of the property.
+     * @param value The value to assign to the property.
+     * @return Status of the operation performed; `MSTAT_PROPERTY_NOT_FOUND` if there is
+     *  no property with this key under this index.
+     */
+    model_status_t (*set_property_by_index)(object_t *obj, size_t index, const object_t *key,
+        object_t *value);
+
     /**
      * @brief Function pointer for adding two objects.
      * 
@@ -516,14 +577,32 @@ typedef struct {
     bool (*call)(object_t *obj, uint16_t arg_count, thread_t *thread);
 } object_vtbl_t;
 
+/**
+ * @def OBJECT_IN_HEAP
+ * @brief Flag of an object allocated in the heap of a process; such an object belongs to
+ *  the process of its slab.
+ */
+#define OBJECT_IN_HEAP 0x01
+
+/**
+ * @def OBJECT_INTERNED
+ * @brief Flag of a static string that is interned: a builtin one, or one created by the symbol
+ *  table of a process and freed together with it. No other interned string has the same text.
+ */
+#define OBJECT_INTERNED 0x02
+
 /**
  * @struct object_t
  * @brief The base object structure in Goat.
  * 
  * This structure represents the base object in the Goat programming language.
  * All objects, whether primitive types, functions, or other user-defined types,
- * share this common structure, which includes a pointer to their virtual table.
+ * share this common header, which includes a pointer to their virtual table.
  * The virtual table enables polymorphic behavior for objects of different types.
+ * 
+ * The header takes 16 bytes on 64-bit platforms. The process owning an object is not stored
+ * in it: objects of a process are allocated in its heap, and the process is found through
+ * the slab containing the object (see `get_object_process()`).
  */
 struct object_t {
     /**
@@ -532,30 +611,136 @@ struct object_t {
     object_vtbl_t *vtbl;
 
     /**
-     * @brief Pointer to the process that owns this object.
-     * 
-     * Each object is associated with a process that manages its lifetime. The process is 
-     * responsible for memory management, including garbage collection and object destruction.
+     * @brief Reference count; objects that are not reference counted (static objects) ignore it.
      */
-    process_t *process;
+    int refs;
 
     /**
-     * @brief Pointer to the previous object in the list.
-     * 
-     * This pointer references the object that precedes the current object in
-     * the doubly linked list.
+     * @brief The state of an object that can be part of a reference cycle (`object_state_t`).
      */
-    object_t *previous;
+    uint8_t state;
 
     /**
-     * @brief Pointer to the next object in the list.
-     * 
-     * This pointer references the object that follows the current object in
-     * the doubly linked list.
+     * @brief Flags of the object (`OBJECT_IN_HEAP`, `OBJECT_INTERNED`).
      */
-    object_t *next;    
+    uint8_t flags;
 };
 
+static_assert(sizeof(object_t) <= 16, "The object header must fit in 16 bytes");
+
+/**
+ * @def TAGGED_INTEGER_MIN
+ * @brief The minimum integer value represented by a tagged pointer.
+ */
+#define TAGGED_INTEGER_MIN (INTPTR_MIN >> 1)
+
+/**
+ * @def TAGGED_INTEGER_MAX
+ * @brief The maximum integer value represented by a tagged pointer.
+ */
+#define TAGGED_INTEGER_MAX (INTPTR_MAX >> 1)
+
+/**
+ * @brief Checks whether a pointer to an object is a tagged integer.
+ * 
+ * Integers in the range `TAGGED_INTEGER_MIN` to `TAGGED_INTEGER_MAX` are not allocated:
+ * the value is stored in the pointer itself, shifted left by one bit, with the lowest bit set.
+ * Real objects are aligned, so the lowest bit of their addresses is always zero.
+ * A tagged integer must never be dereferenced; its virtual table is returned by
+ * `get_object_vtbl()`.
+ * 
+ * @param obj A pointer to the object.
+ * @return `true` if the pointer holds a tagged integer.
+ */
+static inline bool is_tagged_integer(const object_t *obj) {
+    return ((uintptr_t)obj & 1) != 0;
+}
+
+/**
+ * @brief Makes a tagged integer.
+ * @param value The value, must be in the range `TAGGED_INTEGER_MIN` to `TAGGED_INTEGER_MAX`.
+ * @return A pointer holding the value.
+ */
+static inline object_t *make_tagged_integer(int64_t value) {
+    return (object_t *)(((uintptr_t)(intptr_t)value << 1) | 1);
+}
+
+/**
+ * @brief Extracts the value of a tagged integer.
+ * @param obj A pointer holding a tagged integer.
+ * @return The value.
+ */
+static inline int64_t get_tagged_integer_value(const object_t *obj) {
+    return (int64_t)((intptr_t)obj >> 1);
+}
+
+/**
+ * @var tagged_integer_vtbl
+ * @brief Virtual table of tagged integers.
+ * 
+ * Unlike other virtual tables, it is visible outside its module, because tagged integers
+ * have no header that could point to it.
+ */
+extern object_vtbl_t tagged_integer_vtbl;
+
+/**
+ * @brief Retrieves the virtual table of an object.
+ * @param obj A pointer to the object, possibly a tagged integer.
+ * @return A pointer to the virtual table.
+ */
+static inline object_vtbl_t *get_object_vtbl(const object_t *obj) {
+    return is_tagged_integer(obj) ? &tagged_integer_vtbl : obj->vtbl;
+}
+
+/**
+ * @brief Returns the process that owns an object.
+ * @param obj A pointer to the object; it must not be a tagged integer.
+ * @return The process, or `NULL` if the object is static and does not belong to any process.
+ */
+static inline process_t *get_object_process(const object_t *obj) {
+    return (obj->flags & OBJECT_IN_HEAP) ? get_slab(obj)->process : NULL;
+}
+
+/**
+ * @brief Allocates an object in a heap and initializes its header.
+ * @param heap The heap of the process that will own the object.
+ * @param vtbl The virtual table of the object.
+ * @param size The size of the object in bytes.
+ * @return The object holding one reference; the fields following the header are not initialized.
+ */
+static inline object_t *allocate_object(heap_t *heap, object_vtbl_t *vtbl, size_t size) {
+    object_t *obj = (object_t *)allocate_slot(heap, size);
+    obj->vtbl = vtbl;
+    obj->refs = 1;
+    obj->state = ALIVE;
+    obj->flags = OBJECT_IN_HEAP;
+    return obj;
+}
+
+/**
+ * @brief Increments the reference count of an object.
+ * 
+ * Tagged integers have no reference count, so the virtual table is not even consulted
+ * for them.
+ * 
+ * @param obj A pointer to the object.
+ */
+static inline void increment_reference_count(object_t *obj) {
+    if (!is_tagged_integer(obj)) {
+        obj->vtbl->inc_ref(obj);
+    }
+}
+
+/**
+ * @brief Decrements the reference count of an object.
+ * @param obj A pointer to the object.
+ */
+static inline void decrement_reference_count(object_t *obj) {
+    if (!is_tagged_integer(obj)) {
+        obj->vtbl->dec_ref(obj);
+    }
+}
+
 /**
  * @brief Macro to increment the reference count of an object.
  * 
@@ -564,7 +749,7 @@ struct object_t {
  * 
  * @param obj The object whose reference count is to be incremented.
  */
-#define INCREF(obj)  (((object_t*)(obj))->vtbl->inc_ref((object_t*)(obj)))
+#define INCREF(obj)  (increment_reference_count((object_t*)(obj)))
 
 /**
  * @brief Macro to decrement the reference count of an object.
@@ -575,7 +760,7 @@ struct object_t {
  * 
  * @param obj The object whose reference count is to be decremented.
  */
-#define DECREF(obj)  (((object_t*)(obj))->vtbl->dec_ref((object_t*)(obj)))
+#define DECREF(obj)  (decrement_reference_count((object_t*)(obj)))
 
 /**
  * @brief Macro to conditionally decrement the reference count of an object.
@@ -586,7 +771,7 @@ struct object_t {
  * 
  * @param obj The object whose reference count is to be decremented if not NULL.
  */
-#define DECREFIF(obj)  if ((obj) != NULL) { ((object_t*)(obj))->vtbl->dec_ref((object_t*)(obj)); }
+#define DECREFIF(obj)  if ((obj) != NULL) { decrement_reference_count((object_t*)(obj)); }
 
 /**
  * @brief Marks an object during garbage collection.
@@ -597,21 +782,21 @@ struct object_t {
  * @param obj A pointer to the object.
  */
 static inline void mark_object(object_t *obj) {
-    obj->vtbl->mark(obj);
+    if (!is_tagged_integer(obj)) {
+        obj->vtbl->mark(obj);
+    }
 }
 
 /**
- * @brief Sweeps an object during garbage collection.
+ * @brief Sweeps an unreachable object during garbage collection.
  *
- * This helper dispatches to the object's virtual table and performs
- * sweep logic for the object.
+ * This helper dispatches to the object's virtual table and destroys the object
+ * without touching its children.
  *
  * @param obj A pointer to the object.
- * @return `true` if the object was destroyed or moved to object pool,
- *  `false` if it remains alive.
  */
-static inline bool sweep_object(object_t *obj) {
-    return obj->vtbl->sweep(obj);
+static inline void sweep_object(object_t *obj) {
+    obj->vtbl->sweep(obj);
 }
 
 /**
@@ -637,7 +822,7 @@ static inline void release_object(object_t *obj) {
  * @return A negative value if `obj1 < obj2`, zero if equal, positive if `obj1 > obj2`.
  */
 static inline int compare_objects_using_vtbl(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->compare(obj1, obj2);
+    return get_object_vtbl(obj1)->compare(obj1, obj2);
 }
 
 /**
@@ -651,7 +836,7 @@ static inline int compare_objects_using_vtbl(const object_t *obj1, const object_
  * @return A pointer to the cloned object.
  */
 static inline object_t *clone_object(process_t *process, object_t *obj) {
-    return obj->vtbl->clone(process, obj);
+    return get_object_vtbl(obj)->clone(process, obj);
 }
 
 /**
@@ -664,7 +849,7 @@ static inline object_t *clone_object(process_t *process, object_t *obj) {
  * @return The string representation of the object.
  */
 static inline string_value_t convert_object_to_string(const object_t *obj) {
-    return obj->vtbl->to_string(obj);
+    return get_object_vtbl(obj)->to_string(obj);
 }
 
 /**
@@ -677,7 +862,7 @@ static inline string_value_t convert_object_to_string(const object_t *obj) {
  * @return The Goat notation representation of the object.
  */
 static inline string_value_t convert_object_to_string_notation(const object_t *obj) {
-    return obj->vtbl->to_string_notation(obj);
+    return get_object_vtbl(obj)->to_string_notation(obj);
 }
 
 /**
@@ -690,7 +875,7 @@ static inline string_value_t convert_object_to_string_notation(const object_t *o
  * @return The array of immediate prototypes.
  */
 static inline object_array_t get_object_prototypes(const object_t *obj) {
-    return obj->vtbl->get_prototypes(obj);
+    return get_object_vtbl(obj)->get_prototypes(obj);
 }
 
 /**
@@ -703,7 +888,7 @@ static inline object_array_t get_object_prototypes(const object_t *obj) {
  * @return The topologically sorted prototype array.
  */
 static inline object_array_t get_object_topology(const object_t *obj) {
-    return obj->vtbl->get_topology(obj);
+    return get_object_vtbl(obj)->get_topology(obj);
 }
 
 /**
@@ -716,7 +901,7 @@ static inline object_array_t get_object_topology(const object_t *obj) {
  * @return An array containing the object's property keys.
  */
 static inline object_array_t get_object_keys(const object_t *obj) {
-    return obj->vtbl->get_keys(obj);
+    return get_object_vtbl(obj)->get_keys(obj);
 }
 
 /**
@@ -730,7 +915,7 @@ static inline object_array_t get_object_keys(const object_t *obj) {
  * @return The property value, or NULL if not found.
  */
 static inline object_t *get_object_property(const object_t *obj, const object_t *key) {
-    return obj->vtbl->get_property(obj, key);
+    return get_object_vtbl(obj)->get_property(obj, key);
 }
 
 /**
@@ -747,7 +932,7 @@ static inline object_t *get_object_property(const object_t *obj, const object_t
  */
 static inline model_status_t create_object_property(object_t *obj, object_t *key,
         object_t *value, bool constant) {
-    return obj->vtbl->create_property(obj, key, value, constant);
+    return get_object_vtbl(obj)->create_property(obj, key, value, constant);
 }
 
 /**
@@ -762,7 +947,40 @@ static inline model_status_t create_object_property(object_t *obj, object_t *key
  * @return Status of the operation.
  */
 static inline model_status_t set_object_property(object_t *obj, object_t *key, object_t *value) {
-    return obj->vtbl->set_property(obj, key, value);
+    return get_object_vtbl(obj)->set_property(obj, key, value);
+}
+
+/**
+ * @brief Gets a property value from an object by the property index.
+ *
+ * This helper dispatches to the object's virtual table and retrieves
+ * the property value by its index, checking that the property has the expected key.
+ *
+ * @param obj The object from which to retrieve the property.
+ * @param index The property index.
+ * @param key The expected property key.
+ * @return The property value, or NULL if there is no such property under this index.
+ */
+static inline object_t *get_object_property_by_index(const object_t *obj, size_t index,
+        const object_t *key) {
+    return get_object_vtbl(obj)->get_property_by_index(obj, index, key);
+}
+
+/**
+ * @brief Sets a property on an object by the property index.
+ *
+ * This helper dispatches to the object's virtual table and updates
+ * the property value by its index, checking that the property has the expected key.
+ *
+ * @param obj The target object.
+ * @param index The property index.
+ * @param key The expected property key.
+ * @param value The new property value.
+ * @return Status of the operation.
+ */
+static inline model_status_t set_object_property_by_index(object_t *obj, size_t index,
+        const object_t *key, object_t *value) {
+    return get_object_vtbl(obj)->set_property_by_index(obj, index, key, value);
 }
 
 /**
@@ -777,7 +995,7 @@ static inline model_status_t set_object_property(object_t *obj, object_t *key, o
  * @return The resulting object.
  */
 static inline object_t *add_objects(process_t *process, object_t *obj1, object_t *obj2) {
-    return obj1->vtbl->add(process, obj1, obj2);
+    return get_object_vtbl(obj1)->add(process, obj1, obj2);
 }
 
 /**
@@ -792,7 +1010,7 @@ static inline object_t *add_objects(process_t *process, object_t *obj1, object_t
  * @return The resulting object.
  */
 static inline object_t *subtract_objects(process_t *process, object_t *obj1, object_t *obj2) {
-    return obj1->vtbl->subtract(process, obj1, obj2);
+    return get_object_vtbl(obj1)->subtract(process, obj1, obj2);
 }
 
 /**
@@ -807,7 +1025,7 @@ static inline object_t *subtract_objects(process_t *process, object_t *obj1, obj
  * @return The resulting object.
  */
 static inline object_t *multiply_objects(process_t *process, object_t *obj1, object_t *obj2) {
-    return obj1->vtbl->multiply(process, obj1, obj2);
+    return get_object_vtbl(obj1)->multiply(process, obj1, obj2);
 }
 
 /**
@@ -822,7 +1040,7 @@ static inline object_t *multiply_objects(process_t *process, object_t *obj1, obj
  * @return The resulting object.
  */
 static inline object_t *divide_objects(process_t *process, object_t *obj1, object_t *obj2) {
-    return obj1->vtbl->divide(process, obj1, obj2);
+    return get_object_vtbl(obj1)->divide(process, obj1, obj2);
 }
 
 /**
@@ -837,7 +1055,7 @@ static inline object_t *divide_objects(process_t *process, object_t *obj1, objec
  * @return The resulting object.
  */
 static inline object_t *modulo_objects(process_t *process, object_t *obj1, object_t *obj2) {
-    return obj1->vtbl->modulo(process, obj1, obj2);
+    return get_object_vtbl(obj1)->modulo(process, obj1, obj2);
 }
 
 /**
@@ -852,7 +1070,7 @@ static inline object_t *modulo_objects(process_t *process, object_t *obj1, objec
  * @return The resulting object.
  */
 static inline object_t *power_objects(process_t *process, object_t *obj1, object_t *obj2) {
-    return obj1->vtbl->power(process, obj1, obj2);
+    return get_object_vtbl(obj1)->power(process, obj1, obj2);
 }
 
 /**
@@ -865,7 +1083,7 @@ static inline object_t *power_objects(process_t *process, object_t *obj1, object
  * @return `true` if `obj1 < obj2`, `false` otherwise.
  */
 static inline bool is_object_less_than(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->less(obj1, obj2);
+    return get_object_vtbl(obj1)->less(obj1, obj2);
 }
 
 /**
@@ -878,7 +1096,7 @@ static inline bool is_object_less_than(const object_t *obj1, const object_t *obj
  * @return `true` if `obj1 <= obj2`, `false` otherwise.
  */
 static inline bool is_object_less_or_equal(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->less_or_equal(obj1, obj2);
+    return get_object_vtbl(obj1)->less_or_equal(obj1, obj2);
 }
 
 /**
@@ -891,7 +1109,7 @@ static inline bool is_object_less_or_equal(const object_t *obj1, const object_t
  * @return `true` if `obj1 > obj2`, `false` otherwise.
  */
 static inline bool is_object_greater_than(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->greater(obj1, obj2);
+    return get_object_vtbl(obj1)->greater(obj1, obj2);
 }
 
 /**
@@ -904,7 +1122,7 @@ static inline bool is_object_greater_than(const object_t *obj1, const object_t *
  * @return `true` if `obj1 >= obj2`, `false` otherwise.
  */
 static inline bool is_object_greater_or_equal(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->greater_or_equal(obj1, obj2);
+    return get_object_vtbl(obj1)->greater_or_equal(obj1, obj2);
 }
 
 /**
@@ -917,7 +1135,7 @@ static inline bool is_object_greater_or_equal(const object_t *obj1, const object
  * @return `true` if the objects are equal, `false` otherwise.
  */
 static inline bool are_objects_equal(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->equal(obj1, obj2);
+    return get_object_vtbl(obj1)->equal(obj1, obj2);
 }
 
 /**
@@ -930,7 +1148,7 @@ static inline bool are_objects_equal(const object_t *obj1, const object_t *obj2)
  * @return `true` if the objects are not equal, `false` otherwise.
  */
 static inline bool are_objects_not_equal(const object_t *obj1, const object_t *obj2) {
-    return obj1->vtbl->not_equal(obj1, obj2);
+    return get_object_vtbl(obj1)->not_equal(obj1, obj2);
 }
 
 /**
@@ -943,7 +1161,7 @@ static inline bool are_objects_not_equal(const object_t *obj1, const object_t *o
  * @return The boolean value of the object.
  */
 static inline bool get_object_boolean_value(const object_t *obj) {
-    return obj->vtbl->get_boolean_value(obj);
+    return get_object_vtbl(obj)->get_boolean_value(obj);
 }
 
 /**
@@ -956,7 +1174,7 @@ static inline bool get_object_boolean_value(const object_t *obj) {
  * @return The integer value descriptor.
  */
 static inline int_value_t get_object_integer_value(const object_t *obj) {
-    return obj->vtbl->get_integer_value(obj);
+    return get_object_vtbl(obj)->get_integer_value(obj);
 }
 
 /**
@@ -969,7 +1187,7 @@ static inline int_value_t get_object_integer_value(const object_t *obj) {
  * @return The real value descriptor.
  */
 static inline real_value_t get_object_real_value(const object_t *obj) {
-    return obj->vtbl->get_real_value(obj);
+    return get_object_vtbl(obj)->get_real_value(obj);
 }
 
 /**
@@ -984,7 +1202,7 @@ static inline real_value_t get_object_real_value(const object_t *obj) {
  * @return `true` if the call was performed, `false` otherwise.
  */
 static inline bool call_object(object_t *obj, uint16_t arg_count, thread_t *thread) {
-    return obj->vtbl->call(obj, arg_count, thread);
+    return get_object_vtbl(obj)->call(obj, arg_count, thread);
 }
 
 /**
@@ -1032,16 +1250,6 @@ object_t *get_boolean_proto();
  */
 object_t *get_boolean_object(bool value);
 
-/**
- * @brief The minimum static integer value.
- */
-#define MIN_STATIC_INTEGER -1
-
-/**
- * @brief The maximum static integer value.
- */
-#define MAX_STATIC_INTEGER 127
-
 /**
  * @brief Retrieves the prototype for numeric objects (integer and float).
  * @return A pointer to the numeric prototype object.
@@ -1063,12 +1271,8 @@ object_t *get_real_proto();
 /**
  * @brief Retrieves a static integer object.
  * 
- * This function returns a pointer to the static object representing the specified integer value.
- * The input value must be within the range `MIN_STATIC_INTEGER` to `MAX_STATIC_INTEGER`;
- * otherwise, an assertion will fail.
- * 
- * Static integers only store a reference to their value, which exists for the duration
- * of the program's execution. These integers are not managed by the garbage collector.
+ * This function returns a tagged integer representing the specified value. Tagged integers
+ * are not allocated and are not managed by the garbage collector, so no process is needed.
  * 
  * @param value The integer value for which to retrieve the static object.
  * @return A pointer to the static object representing the integer.
@@ -1084,9 +1288,8 @@ object_t *get_integer_zero();
 /**
  * @brief Creates or retrieves an integer object.
  * 
- * This function creates a dynamic integer object if the value is outside the range of static
- * integers. If the value falls within the range of statically pre-initialized integers, the
- * corresponding static object is returned.
+ * If the value fits into a tagged pointer (see `is_tagged_integer()`), a tagged integer is
+ * returned and nothing is allocated. Otherwise, a dynamic integer object is created.
  * 
  * @param process The process that will own the integer object.
  * @param value The integer value to represent.
@@ -1111,6 +1314,13 @@ object_t *get_pi_object();
  */
 object_t *create_real_number_object(process_t *process, double value);
 
+/**
+ * @brief Checks whether an object is a real number (but not the real number prototype).
+ * @param obj The object.
+ * @return `true` if the object is a static or dynamic real number.
+ */
+bool is_real_number(const object_t *obj);
+
 /**
  * @brief Retrieves the string prototype object.
  * @return A pointer to the string prototype object.
@@ -1125,6 +1335,63 @@ object_t *get_string_proto();
  */
 object_t *create_string_object(process_t *process, string_value_t value);
 
+/**
+ * @brief Returns the interned (static) string object with the given text.
+ * 
+ * Looks the text up in the symbol table of the process; if it is not there yet, creates
+ * a static string object that lives as long as the process. Keys and identifiers are
+ * interned, so that they can be compared by address.
+ * 
+ * @param process The process that owns the symbol table.
+ * @param value The text. If it is dynamically allocated, ownership is transferred.
+ * @return A pointer to the interned string object.
+ */
+object_t *intern_string(process_t *process, string_value_t value);
+
+/**
+ * @brief Checks whether a string object is interned.
+ * 
+ * Two interned strings are equal if and only if they are the same object.
+ * 
+ * @param obj The object.
+ * @return `true` if the object is a static string marked with `OBJECT_INTERNED`.
+ */
+bool is_interned_string(const object_t *obj);
+
+/**
+ * @brief Creates a static string object that does not belong to any process.
+ *
+ * Such strings are used as names of the properties of the root context, which is shared
+ * by all processes. They are not interned, so they are compared by text. The object must be
+ * destroyed explicitly.
+ *
+ * @param text The text of the string, it is copied.
+ * @return A pointer to the new string object.
+ */
+object_t *create_static_string_object(const wchar_t *text);
+
+/**
+ * @brief Destroys a string object created by `create_static_string_object`.
+ * @param obj The string object.
+ */
+void destroy_static_string_object(object_t *obj);
+
+/**
+ * @brief Creates a symbol table that maps texts to interned string objects.
+ * 
+ * The table initially contains the static strings declared in the model, so the text
+ * of a builtin identifier is always interned as the builtin object itself.
+ * 
+ * @return A pointer to the new symbol table.
+ */
+avl_tree_t *create_symbol_table();
+
+/**
+ * @brief Destroys a symbol table together with the string objects it created.
+ * @param symbols The symbol table.
+ */
+void destroy_symbol_table(avl_tree_t *symbols);
+
 /**
  * @brief Creates a new user-defined object.
  * @param process The process that will own the created object.
@@ -1137,25 +1404,53 @@ object_t *create_user_defined_object(process_t* process, object_array_t proto);
 /**
  * @brief Creates a new dynamic function object.
  *
- * Allocates and initializes a dynamic function object that stores metadata needed for execution,
- * such as argument names, argument count, starting instruction index, and a closure
- * object.
- *
- * The argument names array (`arg_names`) must be allocated by the caller before invoking this
- * function. Ownership of this array is transferred to the function object, and it will be
- * freed internally during object cleanup. This design avoids one memory allocation,
- * but couples allocation and deallocation logic across module boundaries.
+ * A dynamic function object is just a pair of a template, which describes the arguments and
+ * the entry point and is shared by all functions created by the same instruction, and
+ * a closure object.
  *
  * @param process Pointer to the process to which the function belongs.
- * @param arg_names Array of argument name objects. Ownership is transferred.
- * @param arg_count Number of arguments the function accepts.
- * @param first_instr_id Index of the first instruction to execute in the function body.
+ * @param tmpl Template of the function; it is owned by the process and is not copied.
  * @param closure Closure object to be used as the prototype for the function’s context.
  * 
  * @return Pointer to the newly created function object.
  */
-object_t *create_function_object(process_t *process, object_t **arg_names, size_t arg_count,
-        instr_index_t first_instr_id, object_t *closure);
+object_t *create_function_object(process_t *process, const function_template_t *tmpl,
+        object_t *closure);
+
+/**
+ * @brief Invokes an object as a function, entering it directly if its template is known.
+ *
+ * If the object is a dynamic function created from the given template, it is called without
+ * dispatching through the virtual table. Otherwise (including a `NULL` template), an ordinary
+ * call is performed.
+ *
+ * @param obj A pointer to the object.
+ * @param tmpl The expected template of the function, can be `NULL`.
+ * @param arg_count Number of arguments being passed.
+ * @param thread The thread in which the call is performed.
+ * @return `true` if the call was performed, `false` otherwise.
+ */
+bool call_function_with_template(object_t *obj, const function_template_t *tmpl,
+        uint16_t arg_count, thread_t *thread);
+
+/**
+ * @brief Invokes an object as a function in tail position, reusing the current frame.
+ *
+ * If the object is a dynamic function and the current context is the context of a function,
+ * that context is replaced with the context of the callee, bound to the new arguments, which
+ * takes over its return address, return value slot and unwinding index; the stack is unwound
+ * and execution jumps to the function body. The callee then returns directly to the caller
+ * of the current function.
+ *
+ * Otherwise, an ordinary call is performed, so the instruction following the tail call
+ * must return the result.
+ *
+ * @param obj A pointer to the object.
+ * @param arg_count Number of arguments being passed.
+ * @param thread The thread in which the call is performed.
+ * @return `true` if the call was performed, `false` otherwise.
+ */
+bool tail_call_object(object_t *obj, uint16_t arg_count, thread_t *thread);
 
 /**
  * @brief Macro to declare a getter function for a static object.
@@ -1185,3 +1480,82 @@ DECLARE_STATIC_OBJECT(function_atan)
 DECLARE_STATIC_OBJECT(function_print)
 DECLARE_STATIC_OBJECT(function_sign)
 DECLARE_STATIC_OBJECT(function_sqrt)
+
+/**
+ * @struct native_arguments_t
+ * @brief Borrowed view of the arguments of a native function call.
+ *
+ * The arguments are not copied: the view points to the slots of the data stack that hold
+ * them, and they are popped only after the native function returns. The view is valid
+ * during the call; a native function must not push onto or pop from the data stack.
+ */
+typedef struct {
+    /**
+     * @brief The stack slots holding the arguments; the last argument is in the first slot.
+     */
+    object_t *const *slots;
+
+    /**
+     * @brief The number of arguments.
+     */
+    uint16_t count;
+} native_arguments_t;
+
+/**
+ * @brief Gets an argument of a native function call.
+ * @param args The arguments.
+ * @param index The index of the argument, less than the number of arguments.
+ * @return The argument; the reference is borrowed.
+ */
+static inline object_t *get_native_argument(native_arguments_t args, uint16_t index) {
+    assert(index < args.count);
+    return args.slots[args.count - 1 - index];
+}
+
+/**
+ * @typedef native_function_t
+ * @brief Implementation of a native (built-in or registered) function.
+ *
+ * Returns the result of the call with a reference passed to the caller, or `NULL` if
+ * the function has no result (`null` is used instead).
+ */
+typedef object_t *(*native_function_t)(native_arguments_t args, thread_t *thread);
+
+/**
+ * @brief Creates a function object for a native function.
+ *
+ * Like the built-in functions, the object does not belong to any process and is not
+ * reference counted; it must be destroyed explicitly when no program can use it anymore.
+ *
+ * @param name The name of the function, it is copied.
+ * @param exec The implementation of the function.
+ * @return A pointer to the new function object.
+ */
+object_t *create_native_function_object(const wchar_t *name, native_function_t exec);
+
+/**
+ * @brief Destroys a function object created by `create_native_function_object`.
+ * @param obj The function object.
+ */
+void destroy_native_function_object(object_t *obj);
+
+/**
+ * @brief Registers a native function as a property of the root context.
+ *
+ * The function becomes available to all programs compiled afterwards under the given name,
+ * exactly like the built-in functions. Registration must happen before processes that use
+ * the function are created.
+ *
+ * @param name The name of the function, it is copied.
+ * @param exec The implementation of the function.
+ * @return `true` if the function was registered, `false` if the root context already has
+ *  a property with this name.
+ */
+bool register_native_function(const wchar_t *name, native_function_t exec);
+
+/**
+ * @brief Unregisters and destroys all registered native functions.
+ *
+ * Must be called only when no process exists.
+ */
+void unregister_native_functions();
@@ -1,12 +1,12 @@
 /**
  * @file object_state.h
  * @copyright 2026 Ivan Kniazkov
- * @brief Defines the object states for garbage collection in the Goat language.
+ * @brief Defines the states of objects that can be part of reference cycles.
  * 
  * This file describes the `object_state_t` enum, which is used to track the current state
- * of objects in the Goat programming language. The state of an object is crucial for the
- * garbage collection process, as it helps determine whether an object is active, marked,
- * or has been moved to the object pool for future reuse.
+ * of user-defined objects and functions: whether they are being destroyed, or what the cycle
+ * collector has found out about them. Whether an object has been reached by the full garbage
+ * collection is not a state of the object; it is kept in the mark bitmap of its slab.
  */
 
 #pragma once
@@ -14,27 +14,12 @@
 /**
  * @enum object_state_t
  * @brief Represents the different states of an object in the Goat language.
- * 
- * This enum is used to track the current state of an object during its lifecycle.
- * The state helps the garbage collector determine the object's status, such as whether it needs
- * to be marked, swept, or placed in the object pool for reuse.
  */
 typedef enum {
     /**
-     * @brief The object is not marked for garbage collection.
-     * 
-     * This state indicates that the object is currently not reachable and should be considered
-     * for garbage collection. It has not been marked as in use.
-     */
-    UNMARKED = 0,
-
-    /**
-     * @brief The object is marked for garbage collection.
-     * 
-     * This state indicates that the object has been marked as reachable by the garbage collector.
-     * It is in use and will not be swept or destroyed in the current garbage collection cycle.
+     * @brief The object is alive and is not being processed.
      */
-    MARKED = 1,
+    ALIVE = 0,
 
     /**
      * @brief The object is in the process of being destroyed or cleaned up.
@@ -43,13 +28,21 @@ typedef enum {
      * completed yet. This prevents recursive destruction attempts that could lead to segmentation
      * faults or other issues if the object is encountered again during the cleanup process.
      */
-    DYING = 2,
+    DYING = 1,
+
+    /**
+     * @brief The object is being checked by the cycle collector.
+     * 
+     * The cycle collector has subtracted the references coming from this object from
+     * the reference counts of its children; whatever remains in the reference count of
+     * the object itself comes from the objects not visited yet or from outside.
+     */
+    GRAY = 2,
 
     /**
-     * @brief The object has been moved to the object pool.
+     * @brief The cycle collector has found that the object is referenced only by garbage.
      * 
-     * This state means the object has been removed from active use but instead of being destroyed,
-     * it has been placed in the object pool for potential reuse.
+     * Such objects are destroyed at the end of the cycle collection.
      */
-    ZOMBIE = 3
+    WHITE = 3
 } object_state_t;
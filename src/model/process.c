@@ -11,8 +11,10 @@
 #include "process.h"
 #include "thread.h"
 #include "context.h"
+#include "shape.h"
+#include "function_template.h"
+#include "object.h"
 #include "lib/allocate.h"
-#include "object_list.h"
 
 /**
  * @brief ID of the last created process.
@@ -22,41 +24,30 @@ static uint64_t last_process_id = 0;
 process_t *create_process() {
     process_t *process = (process_t *)CALLOC(sizeof(process_t));
     process->id = ++last_process_id;
-    init_object_list(&process->objects);
-    init_object_list(&process->integers);
-    init_object_list(&process->real_numbers);
-    init_object_list(&process->dynamic_strings);
-    init_object_list(&process->user_defined_objects);
+    process->time_slice = DEFAULT_TIME_SLICE;
+    process->gc_min_threshold = DEFAULT_GC_THRESHOLD;
+    process->gc_growth = DEFAULT_GC_GROWTH;
+    process->gc_threshold = DEFAULT_GC_THRESHOLD;
+    process->possible_roots = create_vector();
+    process->cycle_threshold = DEFAULT_CYCLE_THRESHOLD;
+    process->gc_stack = create_object_stack();
+    init_heap(&process->heap, process);
+    process->symbols = create_symbol_table();
+    process->empty_shape = create_empty_shape();
     create_thread(process, create_context(process, get_root_context(), NULL));
     return process;
 }
 
-/**
- * @brief Destroys all objects in the given list by calling their release function.
- * 
- * This function iterates over the list of objects and calls the `release` function for each
- * object in the list, ensuring proper cleanup of all resources associated with the objects.
- * 
- * @param list A pointer to the object list to be destroyed.
- */
-static void destroy_all_objects_in_the_list(object_list_t *list) {
-    object_t *object = list->head;
-    while (object) {
-        object_t *next = object->next;
-        release_object(object);
-        object = next;
-    }
-}
-
 void destroy_process(process_t *process) {
     while(process->main_thread) {
         destroy_thread(process->main_thread);
     }
-    destroy_all_objects_in_the_list(&process->objects);
-    destroy_all_objects_in_the_list(&process->integers);
-    destroy_all_objects_in_the_list(&process->real_numbers);
-    destroy_all_objects_in_the_list(&process->dynamic_strings);
-    destroy_all_objects_in_the_list(&process->user_defined_objects);
-    FREE(process->string_cache);
+    destroy_heap(&process->heap);
+    destroy_vector(process->possible_roots);
+    destroy_object_stack(process->gc_stack);
+    destroy_shape_tree(process->empty_shape);
+    destroy_function_templates(process->function_templates);
+    destroy_symbol_table(process->symbols);
+    FREE(process->constant_cache);
     FREE(process);
 }
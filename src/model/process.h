@@ -10,7 +10,10 @@
 
 #include <stdint.h>
 
-#include "object_list.h"
+#include "heap.h"
+#include "object_stack.h"
+#include "lib/avl_tree.h"
+#include "lib/vector.h"
 
 /**
  * @typedef process_t
@@ -18,19 +21,88 @@
  */
 typedef struct process_t process_t;
 
+/**
+ * @def DEFAULT_TIME_SLICE
+ * @brief Default number of instructions a thread executes before yielding to the next thread.
+ */
+#define DEFAULT_TIME_SLICE 4096
+
+/**
+ * @def DEFAULT_GC_THRESHOLD
+ * @brief Default number of live objects below which the garbage collector is never started
+ *  during the execution.
+ */
+#define DEFAULT_GC_THRESHOLD 10000
+
+/**
+ * @def DEFAULT_GC_GROWTH
+ * @brief Default growth of the heap, in percent of the objects that survived a collection,
+ *  after which the next collection is started.
+ */
+#define DEFAULT_GC_GROWTH 200
+
+/**
+ * @def DEFAULT_CYCLE_THRESHOLD
+ * @brief Default number of possible roots of garbage cycles that starts the cycle collector.
+ */
+#define DEFAULT_CYCLE_THRESHOLD 4096
+
 /**
  * @typedef thread_t
  * @brief Forward declaration for the thread structure.
  */
 typedef struct thread_t thread_t;
 
+/**
+ * @typedef shape_t
+ * @brief Forward declaration for the shape structure.
+ */
+typedef struct shape_t shape_t;
+
+/**
+ * @typedef function_template_t
+ * @brief Forward declaration for the function template structure.
+ */
+typedef struct function_template_t function_template_t;
+
+/**
+ * @struct gc_statistics_t
+ * @brief Statistics of the garbage collector of a process.
+ */
+typedef struct {
+    /**
+     * @brief The number of collections performed.
+     */
+    size_t collections;
+
+    /**
+     * @brief The number of cycle collections (trial deletions of possible roots) performed.
+     */
+    size_t cycle_collections;
+
+    /**
+     * @brief The total number of objects freed by the collections of both kinds.
+     */
+    size_t freed_objects;
+
+    /**
+     * @brief The total duration of all collections of both kinds, in microseconds.
+     */
+    size_t total_pause;
+
+    /**
+     * @brief The duration of the longest collection, in microseconds.
+     */
+    size_t max_pause;
+} gc_statistics_t;
+
 /**
  * @struct process_t
  * @brief Represents a process in Goat.
  * 
  * A process is an executing program within the Goat language. Each process has an isolated set
- * of data, which is represented as objects. These objects are stored in an object list, which is
- * also used by the garbage collector to manage the lifecycle of objects and perform
+ * of data, which is represented as objects. These objects are stored in the heap of the process,
+ * which is also used by the garbage collector to manage the lifecycle of objects and perform
  * memory cleanup.
  * 
  * A process has at least one thread, and threads are organized in a circular linked list.
@@ -54,73 +126,138 @@ struct process_t {
     thread_t *main_thread;
 
     /**
-     * @brief List of objects managed by the process.
+     * @brief The heap holding the objects created by the process.
+     * 
+     * The garbage collector marks the reachable objects in the bitmaps of the heap and then
+     * sweeps the heap.
+     */
+    heap_t heap;
+
+    /**
+     * @brief Cache of constants used during the execution of the process.
+     * 
+     * This array, indexed by data descriptors, holds pointers to the objects that are created
+     * from the static data of the bytecode: strings and numeric constants. When such an object
+     * is created, it is stored in this cache; if the same constant is loaded again, it is
+     * retrieved from the cache instead of being recreated. The cache holds a reference to each
+     * object and is a root for the garbage collector, so cached objects live as long as the
+     * bytecode runs.
+     */
+    object_t **constant_cache;
+
+    /**
+     * @brief The size of the constant cache.
+     */
+    size_t constant_cache_size;
+
+    /**
+     * @brief Symbol table: maps texts to interned string objects.
+     * 
+     * Strings loaded from the bytecode (identifiers, property keys and literals) are interned,
+     * so that each text is represented by a single static string object and keys can be
+     * compared by address.
+     */
+    avl_tree_t *symbols;
+
+    /**
+     * @brief The empty shape, the root of the shape transition tree of the process.
+     * 
+     * All user-defined objects of the process start with this shape and move along the tree
+     * as properties are added, so objects built the same way share the same shape.
+     */
+    shape_t *empty_shape;
+
+    /**
+     * @brief Templates of the user-defined functions created by the process.
+     * 
+     * A template is created the first time a `FUNC` instruction is executed and is shared by
+     * all functions created by that instruction. Templates are freed with the process.
+     */
+    function_template_t *function_templates;
+
+    /**
+     * @brief Prototype epoch: a counter that changes whenever a lookup through
+     *  prototype chains may start giving a different result.
+     * 
+     * It is advanced when a property is added to an object that serves as a prototype
+     * of another object, and when such an object is destroyed. As long as the epoch
+     * stays the same, a property that was not found in a prototype chain is still not there,
+     * and a property that was found is still found in the same object. The virtual machine
+     * relies on this to validate its inline caches with a single comparison.
+     */
+    uint64_t prototype_epoch;
+
+    /**
+     * @brief Time slice (quantum) of the thread scheduler, in instructions.
+     * 
+     * When the process has several threads, each thread executes this number of instructions
+     * before the control passes to the next thread in the ring. Initialized with
+     * `DEFAULT_TIME_SLICE`; zero also means the default.
+     */
+    uint32_t time_slice;
+
+    /**
+     * @brief The number of live objects below which no collection is started during
+     *  the execution.
      * 
-     * This list contains all the objects created by the process. The garbage collector
-     * uses this list to identify and clean up unused objects.
+     * Reference counting frees most objects as soon as they become unreachable; only cycles
+     * need the garbage collector. Initialized with `DEFAULT_GC_THRESHOLD`; zero disables
+     * collections during the execution (the final collection is still performed).
      */
-    object_list_t objects;
+    size_t gc_min_threshold;
 
     /**
-     * @brief Pool of integer objects managed by the process.
+     * @brief How much the heap may grow after a collection before the next one is started,
+     *  in percent of the objects that survived the collection.
      * 
-     * This list contains objects of type `object_dynamic_integer_t` that were removed by the
-     * garbage collector. Instead of releasing their memory back to the heap, these objects are
-     * stored here for reuse, allowing faster allocation of new integer objects.
+     * Initialized with `DEFAULT_GC_GROWTH`; values below 100 are treated as 100.
      */
-    object_list_t integers;
+    uint32_t gc_growth;
 
     /**
-     * @brief Pool of real number objects managed by the process.
+     * @brief The number of live objects at which the next collection is started.
      * 
-     * This list contains objects of type `object_dynamic_real_t` that were collected
-     * by the garbage collector. Rather than immediately freeing their memory, these
-     * objects are retained in this pool for potential reuse.
+     * The virtual machine compares the number of objects in the heap with this value at safe
+     * points; it is recalculated after each collection.
      */
-    object_list_t real_numbers;
+    size_t gc_threshold;
 
     /**
-     * @brief Pool of dynamic string objects managed by the process.
+     * @brief Possible roots of garbage cycles.
      * 
-     * This list contains objects of type `object_dynamic_string_t` that were removed by the
-     * garbage collector. Instead of releasing their memory back to the heap, these objects
-     * are stored here for reuse. Only the memory holding the string data is freed,
-     * while the object itself remains in the pool, allowing faster allocation of new dynamic
-     * string objects.
+     * An object that can be part of a reference cycle is recorded here when its reference
+     * count is decremented but does not reach zero. Destroyed objects leave `NULL` in their
+     * slots. The cycle collector checks the recorded objects and empties the list.
      */
-    object_list_t dynamic_strings;
+    vector_t *possible_roots;
 
     /**
-     * @brief Pool of user-defined objects managed by the process.
+     * @brief The number of slots in the list of possible roots that starts the cycle collector.
      * 
-     * This list contains objects of type `object_user_defined_t` that were removed by the
-     * garbage collector. When a user-defined object is cleaned up, its collection of child 
-     * objects (key-value pairs) and list of prototypes are cleared. However, the object itself 
-     * is retained in the pool for reuse, avoiding the overhead of allocating new memory for 
-     * user-defined objects during future object creation.
+     * Initialized with `DEFAULT_CYCLE_THRESHOLD`; zero disables the cycle collector, leaving
+     * cycles to the full garbage collection.
      */
-    object_list_t user_defined_objects;
+    size_t cycle_threshold;
 
     /**
-     * @brief Cache of strings used during the execution of the process.
+     * @brief Work stack of the garbage collectors.
      * 
-     * This array holds pointers to string objects that are created during the execution
-     * of the process. When a string is created from bytecode data, it is stored in this cache.
-     * If the same string is encountered again, it is retrieved from the cache instead of being
-     * recreated.
+     * Objects whose children still have to be visited are pushed onto this stack, so walking
+     * the object graph does not use the native stack, however deep the graph is. The stack
+     * is empty between collections.
      */
-    object_t **string_cache;
+    object_stack_t *gc_stack;
 
     /**
-     * @brief The size of the string cache.
+     * @brief Statistics of the garbage collector.
      */
-    size_t string_cache_size;
+    gc_statistics_t gc_statistics;
 };
 
 /**
  * @brief Creates a new process.
  * 
- * This function initializes a new process, sets its unique ID, initializes an empty object list, 
+ * This function initializes a new process, sets its unique ID, initializes an empty heap 
  * and creates the main thread for the process.
  * 
  * @return A pointer to the newly created process.
@@ -131,7 +268,7 @@ process_t *create_process();
  * @brief Destroys a process and frees all its resources, including threads and objects.
  * 
  * This function destroys all threads associated with the process, calls the `release` 
- * function for each object in the process's object list, and then deallocates the memory 
+ * function for each object in the process's heap, and then deallocates the memory 
  * used by the process itself.
  * 
  * @param process The process to be destroyed.
@@ -17,22 +17,11 @@
 #include <math.h>
 
 #include "object.h"
-#include "object_state.h"
 #include "process.h"
 #include "common_methods.h"
 #include "lib/allocate.h"
 #include "lib/string_ext.h"
 
-/**
- * @def POOL_CAPACITY
- * @brief Defines the maximum capacity of the object pool.
- * 
- * This macro sets the maximum number of objects that can be stored in the object pool 
- * before it reaches its capacity. Once the pool is full, any swept objects are destroyed 
- * instead of being added to the pool.
- */
-#define POOL_CAPACITY 1024
-
 /**
  * @struct object_static_real_t
  * @brief Structure representing a static real number object.
@@ -56,8 +45,6 @@ typedef struct {
  */
 typedef struct {
     object_t base; ///< The base object that provides common functionality.
-    int refs; ///< Reference count for garbage collection.
-    object_state_t state; ///< The state of the object (unmarked, marked, or zombie).
     double value; ///< The double-precision floating-point value of the object.
 } object_dynamic_real_t;
 
@@ -140,7 +127,7 @@ static object_vtbl_t real_proto_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -152,6 +139,8 @@ static object_vtbl_t real_proto_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -185,34 +174,12 @@ object_t *get_real_proto() {
     return &real_proto;
 }
 
-/**
- * @brief Releases or clears a dynamic real number object.
- * 
- * This function either frees the object or resets its state and moves it to a list of reusable
- * objects, depending on the number of objects in the pool.
- * 
- * @param diobj The dynamic real number object to release or clear.
- */
-static void release_or_clear(object_dynamic_real_t *drobj) {
-    remove_object_from_list(&drobj->base.process->objects, &drobj->base);
-    if (drobj->base.process->integers.size == POOL_CAPACITY) {
-        FREE(drobj);
-    } else {
-        drobj->refs = 0;
-        drobj->state = ZOMBIE;
-        drobj->value = 0;
-        add_object_to_list(&drobj->base.process->real_numbers, &drobj->base);
-    }
-}
-
 /**
  * @brief Increments the reference count of an object.
  * @param obj The object whose reference count is to be incremented.
  */
 static void inc_ref(object_t *obj) {
-    object_dynamic_real_t *drobj = (object_dynamic_real_t *)obj;
-    assert(drobj->state != ZOMBIE);
-    drobj->refs++;
+    obj->refs++;
 }
 
 /**
@@ -220,10 +187,8 @@ static void inc_ref(object_t *obj) {
  * @param obj The object whose reference count is to be decremented.
  */
 static void dec_ref(object_t *obj) {
-    object_dynamic_real_t *drobj = (object_dynamic_real_t *)obj;
-    assert(drobj->state != ZOMBIE);
-    if (!(--drobj->refs)) {
-        release_or_clear(drobj);
+    if (!(--obj->refs)) {
+        free_slot(obj);
     }
 }
 
@@ -232,39 +197,15 @@ static void dec_ref(object_t *obj) {
  * @param obj The object to mark as reachable.
  */
 static void mark(object_t *obj) {
-    object_dynamic_real_t *drobj = (object_dynamic_real_t *)obj;
-    assert(drobj->state != ZOMBIE);
-    drobj->state = MARKED;
+    mark_slot(obj);
 }
 
 /**
- * @brief Sweeps the object, cleaning it up or moving it to the object pool.
+ * @brief Sweeps the object, returning its slot to the heap.
  * @param obj The object to sweep.
- * @return true if the object was either destroyed or moved to object pool (ZOMBIE),
- *         false if the object was marked (still alive) and shouldn't be processed.
  */
-static bool sweep(object_t *obj) {
-    object_dynamic_real_t *drobj = (object_dynamic_real_t *)obj;
-    assert(drobj->state != ZOMBIE);
-    if (drobj->state == UNMARKED) {
-        release_or_clear(drobj);
-        return true;
-    } else {
-        drobj->state = UNMARKED;
-        return false;
-    }
-}
-
-/**
- * @brief Releases a real number object.
- * @param obj The object to release.
- */
-static void release(object_t *obj) {
-    object_dynamic_real_t *diobj = (object_dynamic_real_t *)obj;
-    remove_object_from_list(
-        diobj->state == ZOMBIE ? &obj->process->real_numbers : &obj->process->objects, obj
-    );
-    FREE(obj);
+static void sweep(object_t *obj) {
+    free_slot(obj);
 }
 
 /**
@@ -294,7 +235,7 @@ static int compare(const object_t *obj1, const object_t *obj2) {
  *  object is returned; otherwise, a new object is created.
  */
 static object_t *clone(process_t *process, object_t *obj) {
-    if (process == obj->process) {
+    if (process == get_object_process(obj)) {
         return obj;
     }
     return create_real_number_object(process, get_object_real_value(obj).value);
@@ -545,7 +486,7 @@ static object_vtbl_t static_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare,
     .clone = clone,
@@ -557,6 +498,8 @@ static object_vtbl_t static_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = add,
     .subtract = subtract,
     .multiply = multiply,
@@ -599,7 +542,7 @@ static object_vtbl_t dynamic_vtbl = {
     .dec_ref = dec_ref,
     .mark = mark,
     .sweep = sweep,
-    .release = release,
+    .release = stub_memory_function,
     .compare = compare,
     .clone = clone,
     .to_string = to_string,
@@ -610,6 +553,8 @@ static object_vtbl_t dynamic_vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = add,
     .subtract = subtract,
     .multiply = multiply,
@@ -629,17 +574,12 @@ static object_vtbl_t dynamic_vtbl = {
 };
 
 object_t *create_real_number_object(process_t *process, double value) {
-    object_dynamic_real_t *obj;
-    if (process->real_numbers.size > 0) {
-        obj = (object_dynamic_real_t *)remove_first_object_from_list(&process->real_numbers);
-    } else {
-        obj = (object_dynamic_real_t *)CALLOC(sizeof(object_dynamic_real_t));
-        obj->base.vtbl = &dynamic_vtbl;
-        obj->base.process = process;
-    }
-    obj->refs = 1;
-    obj->state = UNMARKED;
+    object_dynamic_real_t *obj = (object_dynamic_real_t *)allocate_object(&process->heap,
+        &dynamic_vtbl, sizeof(object_dynamic_real_t));
     obj->value = value;
-    add_object_to_list(&process->objects, &obj->base);
     return &obj->base;
 }
+
+bool is_real_number(const object_t *obj) {
+    return !is_tagged_integer(obj) && (obj->vtbl == &dynamic_vtbl || obj->vtbl == &static_vtbl);
+}
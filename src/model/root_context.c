@@ -13,24 +13,50 @@
  * It is used to initialize the execution environment and is typically referenced by the program
  * during the initial setup phase, where the context's data forms the foundation for all subsequent
  * program execution.
+ * 
+ * Besides the built-in functions, the root context holds native functions registered
+ * by an embedder with `register_native_function`.
  */
 
 #include "context.h"
 #include "object.h"
 #include "common_methods.h"
+#include "lib/allocate.h"
+#include "lib/avl_tree.h"
 #include "lib/pair.h"
 #include "lib/string_ext.h"
+#include "lib/vector.h"
+
+/*
+    The registry belongs to the root context, which is a singleton shared by all processes:
+    the compiler resolves names against it before any process exists, so a native function
+    can not be registered per process. An embedder registers its functions once, before
+    compiling and running programs, and unregisters them when no process is left.
+*/
 
 /**
- * @brief Retrieves all property keys from the root context.
+ * @var registered_keys
+ * @brief Names of all properties of the root context (built-in ones first) if any native
+ *  function is registered, `NULL` otherwise.
+ */
+static vector_t *registered_keys = NULL;
+
+/**
+ * @var registered_functions
+ * @brief Registered native functions, keyed by the text of their names, or `NULL` if none is
+ *  registered.
+ */
+static avl_tree_t *registered_functions = NULL;
+
+/**
+ * @brief Retrieves the keys of the built-in properties of the root context.
  * 
  * This function returns a static array containing the property keys associated with the root
  * context. The array is initialized lazily during the first invocation of the function.
  * 
- * @param obj The object from which to retrieve the keys (ignored).
- * @return An object array containing all property keys.
+ * @return An object array containing the built-in property keys.
  */
-static object_array_t get_keys(const object_t *obj) {
+static object_array_t get_builtin_keys() {
     static object_t *keys[5] = { NULL };
     if (keys[0] == NULL) {
         keys[0] = get_string_atan();
@@ -42,16 +68,46 @@ static object_array_t get_keys(const object_t *obj) {
     return (object_array_t){ keys, sizeof(keys) / sizeof(object_t*) };
 }
 
+/**
+ * @brief Retrieves all property keys from the root context.
+ * @param obj The object from which to retrieve the keys (ignored).
+ * @return An object array containing all property keys, the names of registered native
+ *  functions included.
+ */
+static object_array_t get_keys(const object_t *obj) {
+    if (registered_keys != NULL) {
+        return (object_array_t){ (object_t **)registered_keys->data, registered_keys->size };
+    }
+    return get_builtin_keys();
+}
+
 /**
  * @brief Retrieves the value of a property from the root context.
+ * 
+ * Builtin names are interned as the static strings declared in the model, so an interned key
+ * is matched by address; other string keys are searched for by text. Registered native
+ * functions are searched for by text.
+ * 
  * @param obj The root context object (unused in this implementation).
  * @param key The key of the property to retrieve.
  * @return The value of the property if found, otherwise `NULL`.
 */
 static object_t *get_property(const object_t *obj, const object_t *key) {
     object_t *value = NULL;
-    if (key->vtbl->type == TYPE_STRING) {
-        string_value_t key_str = key->vtbl->to_string(key);
+    if (is_interned_string(key)) {
+        if (key == get_string_atan()) {
+            value = get_function_atan();
+        } else if (key == get_string_pi()) {
+            value = get_pi_object();
+        } else if (key == get_string_print()) {
+            value = get_function_print();
+        } else if (key == get_string_sign()) {
+            value = get_function_sign();
+        } else if (key == get_string_sqrt()) {
+            value = get_function_sqrt();
+        }
+    } else if (get_object_vtbl(key)->type == TYPE_STRING) {
+        string_value_t key_str = convert_object_to_string(key);
         static pair_t properties[] = { 
             { L"atan", get_function_atan },
             { L"pi", get_pi_object },
@@ -67,6 +123,12 @@ static object_t *get_property(const object_t *obj, const object_t *key) {
             value = getter();
         }
     }
+    if (value == NULL && registered_functions != NULL
+            && get_object_vtbl(key)->type == TYPE_STRING) {
+        string_value_t key_str = convert_object_to_string(key);
+        value = (object_t *)get_from_avl_tree(registered_functions, key_str.data).ptr;
+        FREE_STRING(key_str);
+    }
     return value;
 }
 
@@ -79,7 +141,7 @@ static object_vtbl_t vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -91,6 +153,8 @@ static object_vtbl_t vtbl = {
     .get_property = get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -129,3 +193,53 @@ static context_t root_context = {
 context_t *get_root_context() {
     return &root_context;
 }
+
+bool register_native_function(const wchar_t *name, native_function_t exec) {
+    object_array_t keys = get_keys(&root_context_data);
+    for (size_t index = 0; index < keys.size; index++) {
+        string_value_t key_str = convert_object_to_string(keys.items[index]);
+        bool same = wcscmp(key_str.data, name) == 0;
+        FREE_STRING(key_str);
+        if (same) {
+            return false;
+        }
+    }
+    object_t *key = create_static_string_object(name);
+    if (registered_functions == NULL) {
+        object_array_t builtin_keys = get_builtin_keys();
+        registered_functions = create_avl_tree(string_comparator);
+        registered_keys = create_vector();
+        for (size_t index = 0; index < builtin_keys.size; index++) {
+            append_to_vector(registered_keys, builtin_keys.items[index]);
+        }
+    }
+    string_value_t key_str = convert_object_to_string(key);
+    set_in_avl_tree(registered_functions, (void *)key_str.data,
+        (value_t){ .ptr = create_native_function_object(name, exec) });
+    append_to_vector(registered_keys, key);
+    return true;
+}
+
+/**
+ * @brief Destroys a registered native function.
+ * @param unused Unused parameter (required by AVL tree traversal interface).
+ * @param key The name of the function (owned by the key object).
+ * @param value The function object.
+ */
+static void destroy_registered_function(void *unused, void *key, value_t value) {
+    destroy_native_function_object((object_t *)value.ptr);
+}
+
+void unregister_native_functions() {
+    if (registered_functions == NULL) {
+        return;
+    }
+    avl_tree_for_each(registered_functions, destroy_registered_function, NULL);
+    destroy_avl_tree(registered_functions);
+    registered_functions = NULL;
+    for (size_t index = get_builtin_keys().size; index < registered_keys->size; index++) {
+        destroy_static_string_object((object_t *)registered_keys->data[index]);
+    }
+    destroy_vector(registered_keys);
+    registered_keys = NULL;
+}
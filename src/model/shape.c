@@ -0,0 +1,128 @@
+/**
+ * @file shape.c
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Implementation of shapes (hidden classes) of user-defined objects.
+ *
+ * Small shapes are searched linearly: comparing a handful of keys is cheaper than walking
+ * a tree, especially since keys are usually interned strings that are matched by address
+ * (two different interned strings never have the same text). Shapes with many properties
+ * that are searched often get a tree that maps keys to indexes.
+ */
+
+#include <memory.h>
+#include <stdint.h>
+
+#include "shape.h"
+#include "object.h"
+#include "lib/allocate.h"
+
+/**
+ * @def LINEAR_SEARCH_LIMIT
+ * @brief Maximum number of properties of a shape searched linearly without an index map,
+ *  and the number of linear searches after which a larger shape gets its index map.
+ */
+#define LINEAR_SEARCH_LIMIT 8
+
+int compare_property_keys(const void *first, const void *second) {
+    object_t *obj1 = (object_t *)first;
+    object_t *obj2 = (object_t *)second;
+    object_type_t type1 = get_object_vtbl(obj1)->type;
+    object_type_t type2 = get_object_vtbl(obj2)->type;
+    if (type1 > type2) {
+        return 1;
+    } else if (type1 < type2) {
+        return -1;
+    } else {
+        return compare_objects_using_vtbl(obj1, obj2);
+    }
+}
+
+shape_t *create_empty_shape() {
+    shape_t *shape = (shape_t *)CALLOC(sizeof(shape_t));
+    shape->transitions = create_vector();
+    return shape;
+}
+
+/**
+ * @brief Finds a property in a shape by linear search.
+ * @param shape The shape.
+ * @param key The key of the property.
+ * @return The index of the property, or `SIZE_MAX` if the shape does not have this key.
+ */
+static size_t linear_search(const shape_t *shape, const object_t *key) {
+    for (size_t index = 0; index < shape->count; index++) {
+        if (shape->keys[index] == key) {
+            return index;
+        }
+    }
+    bool interned = is_interned_string(key);
+    for (size_t index = 0; index < shape->count; index++) {
+        object_t *other = shape->keys[index];
+        if (!(interned && is_interned_string(other)) && compare_property_keys(other, key) == 0) {
+            return index;
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t find_property_in_shape(shape_t *shape, const object_t *key) {
+    if (shape->index == NULL) {
+        if (shape->count <= LINEAR_SEARCH_LIMIT || ++shape->lookups < LINEAR_SEARCH_LIMIT) {
+            return linear_search(shape, key);
+        }
+        shape->index = create_avl_tree(compare_property_keys);
+        for (size_t index = 0; index < shape->count; index++) {
+            set_in_avl_tree(shape->index, shape->keys[index],
+                (value_t){ .uint32_val = (uint32_t)(index + 1) });
+        }
+    }
+    uint32_t position = get_from_avl_tree(shape->index, key).uint32_val;
+    return position > 0 ? position - 1 : SIZE_MAX;
+}
+
+shape_t *add_property_to_shape(shape_t *shape, object_t *key, bool constant) {
+    for (size_t index = 0; index < shape->transitions->size; index++) {
+        shape_t *child = (shape_t *)shape->transitions->data[index];
+        if (child->constant[shape->count] == constant
+                && compare_property_keys(child->keys[shape->count], key) == 0) {
+            return child;
+        }
+    }
+    shape_t *child = (shape_t *)CALLOC(sizeof(shape_t));
+    child->parent = shape;
+    child->count = shape->count + 1;
+    child->keys = (object_t **)ALLOC(child->count * sizeof(object_t *));
+    child->constant = (bool *)ALLOC(child->count * sizeof(bool));
+    if (shape->count > 0) {
+        memcpy(child->keys, shape->keys, shape->count * sizeof(object_t *));
+        memcpy(child->constant, shape->constant, shape->count * sizeof(bool));
+    }
+    child->keys[shape->count] = key;
+    child->constant[shape->count] = constant;
+    child->transitions = create_vector();
+    INCREF(key);
+    append_to_vector(shape->transitions, child);
+    return child;
+}
+
+void mark_shape_tree(shape_t *shape) {
+    if (shape->count > 0) {
+        mark_object(shape->keys[shape->count - 1]);
+    }
+    for (size_t index = 0; index < shape->transitions->size; index++) {
+        mark_shape_tree((shape_t *)shape->transitions->data[index]);
+    }
+}
+
+void destroy_shape_tree(shape_t *shape) {
+    for (size_t index = 0; index < shape->transitions->size; index++) {
+        destroy_shape_tree((shape_t *)shape->transitions->data[index]);
+    }
+    destroy_vector(shape->transitions);
+    if (shape->index != NULL) {
+        destroy_avl_tree(shape->index);
+    }
+    FREE(shape->keys);
+    FREE(shape->constant);
+    FREE(shape);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file shape.h
+ * @copyright 2026 Ivan Kniazkov
+ * @brief Shapes (hidden classes) describing the layout of user-defined objects.
+ *
+ * A shape is an ordered list of property keys together with their attributes. Objects that
+ * received the same properties in the same order share the same shape and store only
+ * the values, in an array indexed by the position of the key in the shape. Shapes form
+ * a transition tree: adding a property to an object moves it from its shape to a child
+ * shape, which is created once and then reused by all objects built the same way.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "lib/avl_tree.h"
+#include "lib/vector.h"
+
+/**
+ * @typedef object_t
+ * @brief Forward declaration for the object structure.
+ */
+typedef struct object_t object_t;
+
+/**
+ * @typedef shape_t
+ * @brief Forward declaration for the shape structure.
+ */
+typedef struct shape_t shape_t;
+
+/**
+ * @struct shape_t
+ * @brief A node of the shape transition tree.
+ */
+struct shape_t {
+    /**
+     * @brief The shape this one was derived from by adding the last property,
+     *  or `NULL` for the empty shape.
+     */
+    shape_t *parent;
+
+    /**
+     * @brief Number of properties described by the shape.
+     */
+    size_t count;
+
+    /**
+     * @brief Keys of the properties, in the order they were added.
+     *
+     * Stored separately from the attributes so that the keys can be returned as
+     * an object array without copying.
+     */
+    object_t **keys;
+
+    /**
+     * @brief Attributes of the properties, in the same order as the keys.
+     */
+    bool *constant;
+
+    /**
+     * @brief Child shapes, each one having one more property.
+     */
+    vector_t *transitions;
+
+    /**
+     * @brief Map from keys to property indexes (index + 1), built on demand
+     *  for shapes with many properties.
+     */
+    avl_tree_t *index;
+
+    /**
+     * @brief Number of lookups performed by linear search; when it gets large enough,
+     *  the index map is built.
+     */
+    size_t lookups;
+};
+
+/**
+ * @brief Compares two property keys.
+ *
+ * Keys are ordered by type first, then by the comparison method of the type
+ * (for strings, lexicographically).
+ *
+ * @param first The first key.
+ * @param second The second key.
+ * @return A negative value, zero, or a positive value, as for `strcmp`.
+ */
+int compare_property_keys(const void *first, const void *second);
+
+/**
+ * @brief Creates an empty shape, the root of a transition tree.
+ * @return A pointer to the new shape.
+ */
+shape_t *create_empty_shape();
+
+/**
+ * @brief Finds a property in a shape.
+ * @param shape The shape.
+ * @param key The key of the property.
+ * @return The index of the property, or `SIZE_MAX` if the shape does not have this key.
+ */
+size_t find_property_in_shape(shape_t *shape, const object_t *key);
+
+/**
+ * @brief Returns the shape that has one more property than the given one.
+ *
+ * If the transition already exists, the existing child shape is returned; otherwise, a new
+ * child shape is created. The shape holds a reference to the key.
+ *
+ * @param shape The current shape.
+ * @param key The key of the new property (must not be in the shape yet).
+ * @param constant Whether the new property is constant.
+ * @return The child shape.
+ */
+shape_t *add_property_to_shape(shape_t *shape, object_t *key, bool constant);
+
+/**
+ * @brief Marks the keys of all shapes of a transition tree as reachable.
+ *
+ * Shapes outlive the objects that use them, so their keys are roots for the garbage collector.
+ *
+ * @param shape The root of the transition tree.
+ */
+void mark_shape_tree(shape_t *shape);
+
+/**
+ * @brief Destroys a whole transition tree.
+ *
+ * The keys are not released: the tree is destroyed together with the process that
+ * owns all the objects.
+ *
+ * @param shape The root of the transition tree.
+ */
+void destroy_shape_tree(shape_t *shape);
@@ -11,6 +11,9 @@
  *    - They can also be strings loaded from bytecode.
  *    - Static strings only store a reference to their data, which exists for the duration of the
  *      program's execution. These strings are not managed by the garbage collector.
+ *    - Static strings are interned: each process has a symbol table that maps the text to
+ *      the only static string object with this text, so two static strings are equal if and
+ *      only if they are the same object.
  * 2. Dynamic strings:
  *    - These are created as a result of string operations at runtime.
  *    - They internally store their own data array and are subject to garbage collection
@@ -20,22 +23,13 @@
 #include <assert.h>
 
 #include "object.h"
-#include "object_state.h"
+#include "context.h"
 #include "process.h"
 #include "common_methods.h"
 #include "lib/allocate.h"
+#include "lib/avl_tree.h"
 #include "lib/string_ext.h"
 
-/**
- * @def POOL_CAPACITY
- * @brief Defines the maximum capacity of the object pool.
- * 
- * This macro sets the maximum number of objects that can be stored in the object pool 
- * before it reaches its capacity. Once the pool is full, any swept objects are destroyed 
- * instead of being added to the pool.
- */
-#define POOL_CAPACITY 1024
-
 /**
  * @struct object_static_string_t
  * @brief Structure representing a static string object.
@@ -58,11 +52,19 @@ typedef struct {
  */
 typedef struct {
     object_t base; ///< The base object that provides common functionality.
-    int refs; ///< Reference count used for garbage collection.
-    object_state_t state; ///< The state of the object (e.g., unmarked, marked, or zombie).
     string_view_t string; ///< The string.
 } object_dynamic_string_t;
 
+/**
+ * @brief Checks whether a key is the `length` string.
+ * 
+ * Interned keys are checked by address; other strings are compared by text.
+ * 
+ * @param key The key.
+ * @return `true` if the key is a string with the text `length`.
+ */
+static bool is_string_length(const object_t *key);
+
 /**
  * @brief Retrieves all property keys from a string object.
  * 
@@ -93,14 +95,7 @@ static object_array_t get_keys(const object_t *obj) {
  * @return A pointer to the value of the property, or `NULL` if the key is not recognized.
  */
 static object_t *proto_get_property(const object_t *obj, const object_t *key) {
-    object_t *value = NULL;
-    if (key->vtbl->type == TYPE_STRING) {
-        string_value_t key_str = convert_object_to_string(key);
-        if (wcscmp(L"length", key_str.data) == 0) {
-            value = get_integer_zero();
-        }
-    }
-    return value;
+    return is_string_length(key) ? get_integer_zero() : NULL;
 }
 
 /**
@@ -112,7 +107,7 @@ static object_vtbl_t string_proto_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare_object_addresses,
     .clone = clone_singleton,
@@ -124,6 +119,8 @@ static object_vtbl_t string_proto_vtbl = {
     .get_property = proto_get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = stub_add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -158,27 +155,12 @@ object_t *get_string_proto() {
 }
 
 /**
- * @brief Releases or clears a dynamic string object.
- * 
- * This function manages the lifecycle of a dynamic string object. If the pool of reusable 
- * objects (`dynamic_strings`) in the process has reached its capacity, the object is fully 
- * deallocated. Otherwise, the object is reset (its data memory is freed, and its internal 
- * fields are cleared) and added to the pool for reuse, reducing the overhead of allocating 
- * new objects.
- * 
- * @param dsobj The dynamic string object to release or clear.
+ * @brief Destroys a dynamic string object: frees its data and returns its slot to the heap.
+ * @param dsobj The dynamic string object to destroy.
  */
-static void release_or_clear(object_dynamic_string_t *dsobj) {
+static void destroy(object_dynamic_string_t *dsobj) {
     FREE((wchar_t*)(dsobj->string.data));
-    remove_object_from_list(&dsobj->base.process->objects, &dsobj->base);
-    if (dsobj->base.process->dynamic_strings.size == POOL_CAPACITY) {
-        FREE(dsobj);
-    } else {
-        dsobj->refs = 0;
-        dsobj->state = ZOMBIE;
-        dsobj->string = ( string_view_t ){ NULL, 0 };
-        add_object_to_list(&dsobj->base.process->dynamic_strings, &dsobj->base);
-    }
+    free_slot(dsobj);
 }
 
 /**
@@ -186,9 +168,7 @@ static void release_or_clear(object_dynamic_string_t *dsobj) {
  * @param obj The object whose reference count is to be incremented.
  */
 static void inc_ref(object_t *obj) {
-    object_dynamic_string_t *dsobj = (object_dynamic_string_t *)obj;
-    assert(dsobj->state != ZOMBIE);
-    dsobj->refs++;
+    obj->refs++;
 }
 
 /**
@@ -196,10 +176,8 @@ static void inc_ref(object_t *obj) {
  * @param obj The object whose reference count is to be decremented.
  */
 static void dec_ref(object_t *obj) {
-    object_dynamic_string_t *dsobj = (object_dynamic_string_t *)obj;
-    assert(dsobj->state != ZOMBIE);
-    if (!(--dsobj->refs)) {
-        release_or_clear(dsobj);
+    if (!(--obj->refs)) {
+        destroy((object_dynamic_string_t *)obj);
     }
 }
 
@@ -208,40 +186,24 @@ static void dec_ref(object_t *obj) {
  * @param obj The object to mark as reachable.
  */
 static void mark(object_t *obj) {
-    object_dynamic_string_t *dsobj = (object_dynamic_string_t *)obj;
-    assert(dsobj->state != ZOMBIE);
-    dsobj->state = MARKED;
+    mark_slot(obj);
 }
 
 /**
- * @brief Sweeps the object, cleaning it up or moving it to the object pool.
+ * @brief Sweeps the object, destroying it.
  * @param obj The object to sweep.
- * @return true if the object was either destroyed or moved to object pool (ZOMBIE),
- *         false if the object was marked (still alive) and shouldn't be processed.
  */
-static bool sweep(object_t *obj) {
-    object_dynamic_string_t *dsobj = (object_dynamic_string_t *)obj;
-    assert(dsobj->state != ZOMBIE);
-    if (dsobj->state == UNMARKED) {
-        release_or_clear(dsobj);
-        return true;
-    } else {
-        dsobj->state = UNMARKED;
-        return false;
-    }
+static void sweep(object_t *obj) {
+    destroy((object_dynamic_string_t *)obj);
 }
 
 /**
- * @brief Releases a dynamic string object.
+ * @brief Releases a dynamic string object; its slot is freed together with the heap.
  * @param obj The object to release.
  */
 static void release(object_t *obj) {
     object_dynamic_string_t *dsobj = (object_dynamic_string_t *)obj;
-    remove_object_from_list(
-        dsobj->state == ZOMBIE ? &obj->process->dynamic_strings : &obj->process->objects, obj
-    );
     FREE((wchar_t*)(dsobj->string.data));
-    FREE(obj);
 }
 
 /**
@@ -252,6 +214,9 @@ static void release(object_t *obj) {
  *  negative if obj1 < obj2, 0 if equal.
  */
 static int compare(const object_t *obj1, const object_t *obj2) {
+    if (obj1 == obj2) {
+        return 0;
+    }
     string_value_t first = convert_object_to_string(obj1);
     string_value_t second = convert_object_to_string(obj2);
     int result = wcscmp(first.data, second.data);
@@ -267,7 +232,7 @@ static int compare(const object_t *obj1, const object_t *obj2) {
  *  is returned; otherwise, a new object is created.
  */
 static object_t *clone(process_t *process, object_t *obj) {
-    if (process == obj->process) {
+    if (process == get_object_process(obj)) {
         return obj;
     }
     string_value_t value = convert_object_to_string(obj);
@@ -369,12 +334,9 @@ static object_array_t get_topology(const object_t *obj) {
  * @note A static string has only static properties.
  */
 static object_t *static_get_property(const object_t *obj, const object_t *key) {
-    if (key->vtbl->type == TYPE_STRING) {
+    if (is_string_length(key)) {
         object_static_string_t *stsobj = (object_static_string_t *)obj;
-        string_value_t key_str = convert_object_to_string(key);
-        if (wcscmp(L"length", key_str.data) == 0) {
-            return get_static_integer_object((int)stsobj->string.length);
-        }
+        return get_static_integer_object((int)stsobj->string.length);
     }
     return NULL;
 }
@@ -386,12 +348,9 @@ static object_t *static_get_property(const object_t *obj, const object_t *key) {
  * @return A pointer to the value of the property, or `NULL` if the key is not recognized.
  */
 static object_t *dynamic_get_property(const object_t *obj, const object_t *key) {
-    if (key->vtbl->type == TYPE_STRING) {
+    if (is_string_length(key)) {
         object_dynamic_string_t *dsobj = (object_dynamic_string_t *)obj;
-        string_value_t key_str = convert_object_to_string(key);
-        if (wcscmp(L"length", key_str.data) == 0) {
-            return create_integer_object(obj->process, (int64_t)dsobj->string.length);
-        }
+        return create_integer_object(get_object_process(obj), (int64_t)dsobj->string.length);
     }
     return NULL;
 }
@@ -412,7 +371,7 @@ static object_t *dynamic_get_property(const object_t *obj, const object_t *key)
 static object_t *add(process_t *process, object_t *obj1, object_t *obj2) {
     string_value_t first = convert_object_to_string(obj1);
     if (first.length == 0) {
-        if (obj2->vtbl->type == TYPE_STRING) {
+        if (get_object_vtbl(obj2)->type == TYPE_STRING) {
             INCREF(obj2);
             return obj2;
         }
@@ -455,7 +414,7 @@ static object_vtbl_t static_string_vtbl = {
     .inc_ref = stub_memory_function,
     .dec_ref = stub_memory_function,
     .mark = stub_memory_function,
-    .sweep = no_sweep,
+    .sweep = stub_memory_function,
     .release = stub_memory_function,
     .compare = compare,
     .clone = clone,
@@ -467,6 +426,8 @@ static object_vtbl_t static_string_vtbl = {
     .get_property = static_get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -490,14 +451,16 @@ static object_vtbl_t static_string_vtbl = {
  * 
  * This macro defines a static string object with a specified name and string value. It also
  * provides a function to retrieve the object. The string is stored as a constant literal, and
- * the object is initialized with the appropriate virtual table.
+ * the object is initialized with the appropriate virtual table. Such strings start every symbol
+ * table, so they are interned.
  * 
  * @param name The name of the static string object.
  * @param string The wide-character string literal.
  */
 #define DECLARE_STATIC_STRING(name, string) \
     static object_static_string_t name = \
-        { { &static_string_vtbl, NULL, NULL, NULL }, { (string), sizeof(string) / sizeof(wchar_t) - 1 } }; \
+        { { .vtbl = &static_string_vtbl, .flags = OBJECT_INTERNED }, \
+            { (string), sizeof(string) / sizeof(wchar_t) - 1 } }; \
     object_t *get_##name() { return &name.base; } 
 
 /**
@@ -532,6 +495,8 @@ static object_vtbl_t dynamic_string_vtbl = {
     .get_property = dynamic_get_property,
     .create_property = create_property_on_immutable,
     .set_property = set_property_on_immutable,
+    .get_property_by_index = no_property_by_index,
+    .set_property_by_index = set_property_by_index_on_immutable,
     .add = add,
     .subtract = stub_subtract,
     .multiply = stub_multiply,
@@ -550,23 +515,111 @@ static object_vtbl_t dynamic_string_vtbl = {
     .call = stub_call
 };
 
+static bool is_string_length(const object_t *key) {
+    if (key == &string_length.base) {
+        return true;
+    }
+    if (get_object_vtbl(key) != &dynamic_string_vtbl) {
+        return false;
+    }
+    return wcscmp(L"length", ((object_dynamic_string_t *)key)->string.data) == 0;
+}
+
+/**
+ * @var builtin_symbols
+ * @brief Static strings declared in the model; every symbol table starts with them.
+ */
+static object_static_string_t *builtin_symbols[] = {
+    &empty_string,
+    &string_atan,
+    &string_length,
+    &string_pi,
+    &string_print,
+    &string_sign,
+    &string_sqrt
+};
+
+avl_tree_t *create_symbol_table() {
+    avl_tree_t *symbols = create_avl_tree(string_comparator);
+    size_t count = sizeof(builtin_symbols) / sizeof(object_static_string_t *);
+    for (size_t index = 0; index < count; index++) {
+        object_static_string_t *symbol = builtin_symbols[index];
+        set_in_avl_tree(symbols, (void *)symbol->string.data, (value_t){ .ptr = symbol });
+    }
+    return symbols;
+}
+
+/**
+ * @brief Frees a static string object created by the symbol table.
+ *
+ * Builtin static strings do not belong to any process and are left intact.
+ *
+ * @param unused Unused parameter (required by AVL tree traversal interface).
+ * @param key The text of the symbol (freed together with the object).
+ * @param value The static string object.
+ */
+static void release_symbol(void *unused, void *key, value_t value) {
+    object_static_string_t *symbol = (object_static_string_t *)value.ptr;
+    size_t count = sizeof(builtin_symbols) / sizeof(object_static_string_t *);
+    for (size_t index = 0; index < count; index++) {
+        if (symbol == builtin_symbols[index]) {
+            return;
+        }
+    }
+    FREE((wchar_t *)symbol->string.data);
+    FREE(symbol);
+}
+
+void destroy_symbol_table(avl_tree_t *symbols) {
+    avl_tree_for_each(symbols, release_symbol, NULL);
+    destroy_avl_tree(symbols);
+}
+
+object_t *intern_string(process_t *process, string_value_t value) {
+    object_static_string_t *symbol =
+        (object_static_string_t *)get_from_avl_tree(process->symbols, value.data).ptr;
+    if (symbol == NULL) {
+        symbol = (object_static_string_t *)CALLOC(sizeof(object_static_string_t));
+        symbol->base.vtbl = &static_string_vtbl;
+        symbol->base.flags = OBJECT_INTERNED;
+        symbol->string.data = value.should_free ? value.data : WSTRDUP(value.data);
+        symbol->string.length = value.length;
+        set_in_avl_tree(process->symbols, (void *)symbol->string.data,
+            (value_t){ .ptr = symbol });
+    } else {
+        FREE_STRING(value);
+    }
+    return &symbol->base;
+}
+
+bool is_interned_string(const object_t *obj) {
+    return get_object_vtbl(obj) == &static_string_vtbl && (obj->flags & OBJECT_INTERNED);
+}
+
+object_t *create_static_string_object(const wchar_t *text) {
+    object_static_string_t *obj = (object_static_string_t *)CALLOC(
+        sizeof(object_static_string_t));
+    obj->base.vtbl = &static_string_vtbl;
+    obj->string.data = WSTRDUP(text);
+    obj->string.length = wcslen(text);
+    return &obj->base;
+}
+
+void destroy_static_string_object(object_t *obj) {
+    object_static_string_t *stsobj = (object_static_string_t *)obj;
+    assert(obj->vtbl == &static_string_vtbl && !(obj->flags & OBJECT_INTERNED));
+    FREE((wchar_t *)stsobj->string.data);
+    FREE(stsobj);
+}
+
 object_t *create_string_object(process_t *process, string_value_t value) {
     if (value.length == 0) {
         FREE_STRING(value);
         return get_empty_string();
     }
-    object_dynamic_string_t *obj;
-    if (process->dynamic_strings.size > 0) {
-        obj = (object_dynamic_string_t *)remove_first_object_from_list(&process->dynamic_strings);
-    } else {
-        obj = (object_dynamic_string_t *)CALLOC(sizeof(object_dynamic_string_t));
-        obj->base.vtbl = &dynamic_string_vtbl;
-        obj->base.process = process;
-    }
-    obj->refs = 1;
-    obj->state = UNMARKED;
+    object_dynamic_string_t *obj = (object_dynamic_string_t *)allocate_object(&process->heap,
+        &dynamic_string_vtbl, sizeof(object_dynamic_string_t));
     obj->string.data = value.should_free ? value.data : WSTRDUP(value.data);
     obj->string.length = value.length;
-    add_object_to_list(&process->objects, &obj->base);
     return &obj->base;
 }
@@ -47,6 +47,9 @@ void destroy_thread(thread_t *thread) {
     } else {
         thread->previous->next = thread->next;
         thread->next->previous = thread->previous;
+        if (thread->process->main_thread == thread) {
+            thread->process->main_thread = thread->next;
+        }
     }
     context_t *root_context = get_root_context();
     context_t *context = thread->context;
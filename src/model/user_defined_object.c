@@ -6,13 +6,21 @@
  * This file provides the structure and functionality for a user-defined object type in the
  * Goat programming language. A user-defined object is a general-purpose object that allows storing
  * arbitrary data and methods in the form of key-value pairs.
+ * 
+ * The keys and attributes of the properties are described by a shape shared between objects
+ * that received the same properties in the same order; the object itself stores only
+ * the values, in an array indexed by the position of the key in the shape.
  */
 
 #include <assert.h>
+#include <memory.h>
+#include <stdlib.h>
 
 #include "object.h"
 #include "object_state.h"
+#include "cyclic_object.h"
 #include "process.h"
+#include "shape.h"
 #include "common_methods.h"
 #include "lib/allocate.h"
 #include "lib/avl_tree.h"
@@ -20,14 +28,39 @@
 #include "lib/string_ext.h"
 
 /**
- * @def POOL_CAPACITY
- * @brief Defines the maximum capacity of the object pool.
+ * @def INLINE_PROPERTY_COUNT
+ * @brief Number of property values stored directly in the object.
  * 
- * This macro sets the maximum number of objects that can be stored in the object pool 
- * before it reaches its capacity. Once the pool is full, any swept objects are destroyed 
- * instead of being added to the pool.
+ * Objects with more properties keep their values in a separately allocated array.
  */
-#define POOL_CAPACITY 1024
+#define INLINE_PROPERTY_COUNT 4
+
+/**
+ * @struct topology_t
+ * @brief Shared, reference-counted topology of a prototype list.
+ * 
+ * The prototypes of an object never change after the object is created, so neither does its
+ * topology. All objects created from the same prototype list share one topology: the topology
+ * of objects with a single user-defined prototype is cached in that prototype (it is the
+ * prototype followed by its own topology), and a clone shares the topology of the original.
+ */
+typedef struct {
+    /**
+     * @brief Reference count; every object using the topology, and the prototype caching it,
+     *  hold one reference.
+     */
+    int refs;
+
+    /**
+     * @brief Number of objects in the topology.
+     */
+    size_t size;
+
+    /**
+     * @brief Objects of the topology in order of lookup, stored right after the structure.
+     */
+    object_t *items[];
+} topology_t;
 
 /**
  * @struct object_user_defined_t
@@ -38,108 +71,160 @@ typedef struct {
      * @brief The base object that provides common functionality.
      */
     object_t base;
-    
+
     /**
-     * @brief Reference count.
+     * @brief One-based index of the object in the possible roots of garbage cycles, or 0.
      */
-    int refs;
+    size_t root_index;
 
     /**
-     * @brief The state of the object (e.g., unmarked, marked, or zombie).
+     * @brief Flag indicating that the object is a prototype of some other object.
+     * 
+     * Adding a property to such an object, or destroying it, changes the result of lookups
+     * through prototype chains, so it advances the prototype epoch of the process.
      */
-    object_state_t state;
+    bool is_prototype;
 
     /**
-     * @brief A vector storing the prototypes of the object.
+     * @brief The prototypes of the object.
+     * 
+     * Points either to `inline_proto`, if the object has a single prototype, or to
+     * a separately allocated array.
      */
-    vector_t *proto;
+    object_t **proto;
 
     /**
-     * @brief A vector storing the topology of the object.
+     * @brief The number of prototypes.
      */
-    vector_t *topology;
+    size_t proto_count;
 
     /**
-     * @brief A vector storing keys for all properties of the object.
+     * @brief Storage for the prototype of an object having a single prototype.
      */
-    vector_t *keys;
+    object_t *inline_proto;
 
     /**
-     * @brief AVL tree storing properties, which are key-value pairs where both 
-     *  keys and values are objects.
+     * @brief The topology of the object, shared with other objects having the same prototypes.
      */
-    avl_tree_t *properties;
-} object_user_defined_t;
+    topology_t *topology;
 
-/**
- * @struct property_value_t
- * @brief The value of the object property, namely some other object and flags.
- */
-typedef struct {
     /**
-     * @brief Object which is the value of the property.
+     * @brief Cached topology of objects whose only prototype is this object, or `NULL` if it
+     *  has not been needed yet.
      */
-    object_t *object;
+    topology_t *derived_topology;
 
     /**
-     * @brief Flag indicating that the property value is constant (immutable).
+     * @brief The shape of the object, describing keys and attributes of all its properties.
      */
-    bool is_constant;
-} property_value_t;
+    shape_t *shape;
+
+    /**
+     * @brief Values of the properties, in the same order as the keys in the shape.
+     * 
+     * Points either to `inline_values` or to a separately allocated array.
+     */
+    object_t **values;
+
+    /**
+     * @brief Number of values that fit into the `values` array.
+     */
+    size_t capacity;
+
+    /**
+     * @brief Storage for the values of the first few properties.
+     */
+    object_t *inline_values[INLINE_PROPERTY_COUNT];
+} object_user_defined_t;
+
+static_assert(offsetof(object_user_defined_t, root_index) == offsetof(cyclic_object_t, root_index),
+    "A user-defined object must begin with the fields of a cyclic object");
 
 /**
  * @brief Creates an empty user-defined object.
  * 
- * This function initializes an empty user-defined object. If there are recycled objects 
- * available in the process's pool, one of them is reused. Otherwise, a new object is allocated. 
- * The object is added to the process's object list and initialized with default settings, 
- * including an empty AVL tree for storing key-value pairs.
+ * This function allocates an empty user-defined object in the heap of the process and
+ * initializes it with default settings, including the empty shape of the process.
  * 
  * @param process The process that will own the created object.
  * @param prototypes An array of prototypes that will be associated with the object.
  *  This list defines the inheritance chain and the topology of the object.
- * @return A pointer to the newly created or recycled user-defined object.
+ * @return A pointer to the newly created user-defined object.
  */
 static object_user_defined_t *create_empty_user_defined_object(process_t* process,
         object_array_t prototypes);
 
 /**
- * @brief Decrements the reference count of a key-value pair in the user-defined object's children.
- * 
- * This function is called for each key-value pair in the AVL tree of a user-defined object. 
- * It decreases the reference count of both the key and the value, ensuring proper memory 
- * management and cleanup of referenced objects.
- * 
- * @param unused Unused parameter, included for compatibility with the AVL tree traversal function.
- * @param key The key of the key-value pair, cast to an object.
- * @param value The value of the key-value pair, stored as a `value_t` type.
+ * @brief Creates an empty user-defined object with a given topology.
+ * @param process The process that will own the created object.
+ * @param proto An array of prototypes that will be associated with the object.
+ * @param topology The topology of the prototypes; the reference is transferred to the object.
+ * @return A pointer to the newly created user-defined object.
+ */
+static object_user_defined_t *create_empty_user_defined_object_ex(process_t* process,
+        object_array_t proto, topology_t *topology);
+
+/**
+ * @brief Allocates a topology with one reference.
+ * @param size The number of objects in the topology.
+ * @return A pointer to the new topology; the items must be filled by the caller.
+ */
+static topology_t *create_topology(size_t size) {
+    topology_t *topology = (topology_t *)ALLOC(sizeof(topology_t) + size * sizeof(object_t *));
+    topology->refs = 1;
+    topology->size = size;
+    return topology;
+}
+
+/**
+ * @brief Releases one reference to a topology, destroying it when no references are left.
+ * @param topology The topology, can be `NULL`.
  */
-static void clear_child_pair(void *unused, void *key, value_t value) {
-    DECREF(key);
-    property_value_t *ref = (property_value_t *)value.ptr;
-    DECREF(ref->object);
-    FREE(ref);
+static void release_topology(topology_t *topology) {
+    if (topology != NULL && !(--topology->refs)) {
+        FREE(topology);
+    }
 }
 
 /**
- * @brief Removes a reference to a property value without reference counting.
+ * @brief Releases the topologies used and cached by an object.
  * 
- * This function is used during shallow cleaning to simply free the property value
- * storage without affecting reference counts of referenced objects.
+ * The cached topology of derived objects is dropped together with the object, so a recycled
+ * object never hands out a topology built for its previous life.
  * 
- * @param unused Unused parameter (required by AVL tree traversal interface).
- * @param key The property key (not used in this operation).
- * @param value The property value storage to be freed.
+ * @param uobj The user-defined object.
  */
-static void remove_reference(void *unused, void *key, value_t value) {
-    FREE(value.ptr);
+static void release_topologies(object_user_defined_t *uobj) {
+    release_topology(uobj->topology);
+    uobj->topology = NULL;
+    release_topology(uobj->derived_topology);
+    uobj->derived_topology = NULL;
 }
 
 /**
- * @brief Releases or clears a user-defined object with optional deep cleaning.
+ * @brief Frees the separately allocated array of property values, if any.
+ * @param uobj The user-defined object.
+ */
+static void free_values(object_user_defined_t *uobj) {
+    if (uobj->values != uobj->inline_values) {
+        FREE(uobj->values);
+    }
+}
+
+/**
+ * @brief Frees the separately allocated array of prototypes, if any.
+ * @param uobj The user-defined object.
+ */
+static void free_prototypes(object_user_defined_t *uobj) {
+    if (uobj->proto != &uobj->inline_proto) {
+        FREE(uobj->proto);
+    }
+}
+
+/**
+ * @brief Destroys a user-defined object with optional deep cleaning.
  * 
- * This function handles both destruction and recycling of user-defined objects,
- * with two distinct cleaning modes:
+ * This function handles destruction of user-defined objects, with two distinct cleaning modes:
  * 
  * Deep cleaning (used by `dec_ref`):
  * - Recursively decrements references of all child objects and prototypes
@@ -150,43 +235,34 @@ static void remove_reference(void *unused, void *key, value_t value) {
  * - Preserves child objects for garbage collector to handle
  * - Lets GC manage reference counts in its own order
  * 
- * In both cases, the object is either:
- * - Fully destroyed if object pool is full, or
- * - Reset and moved to zombie pool for reuse
+ * In both cases, the slot of the object is returned to the heap.
  * 
  * @param uobj The user-defined object to process
  * @param deep_cleaning true for recursive reference counting cleanup,
  *  false for immediate resource-only cleanup
  */
-static void release_or_clear(object_user_defined_t *uobj, bool deep_cleaning) {
-    if (uobj->state == DYING) {
+static void destroy(object_user_defined_t *uobj, bool deep_cleaning) {
+    if (uobj->base.state == DYING) {
         return;
     }
+    if (uobj->is_prototype) {
+        get_object_process(&uobj->base)->prototype_epoch++;
+        uobj->is_prototype = false;
+    }
     if (deep_cleaning) {
-        uobj->state = DYING;
-        avl_tree_for_each(uobj->properties, clear_child_pair, NULL);
-        for (size_t index = 0; index < uobj->proto->size; index++) {
-            DECREF((object_t *)uobj->proto->data[index]);
+        uobj->base.state = DYING;
+        for (size_t index = 0; index < uobj->shape->count; index++) {
+            DECREF(uobj->values[index]);
+        }
+        for (size_t index = 0; index < uobj->proto_count; index++) {
+            DECREF(uobj->proto[index]);
         }
-    } else {
-        avl_tree_for_each(uobj->properties, remove_reference, NULL);
-    }
-    remove_object_from_list(&uobj->base.process->objects, &uobj->base);
-    if (uobj->base.process->user_defined_objects.size == POOL_CAPACITY) {
-        destroy_vector(uobj->proto);
-        destroy_vector(uobj->topology);
-        destroy_vector(uobj->keys);
-        destroy_avl_tree(uobj->properties);
-        FREE(uobj);
-    } else {
-        clear_vector(uobj->proto);
-        clear_vector(uobj->topology);
-        clear_vector(uobj->keys);
-        clear_avl_tree(uobj->properties);
-        uobj->refs = 0;
-        uobj->state = ZOMBIE;
-        add_object_to_list(&uobj->base.process->user_defined_objects, &uobj->base);
     }
+    remove_possible_root((cyclic_object_t *)uobj);
+    release_topologies(uobj);
+    free_prototypes(uobj);
+    free_values(uobj);
+    free_slot(uobj);
 }
 
 /**
@@ -194,9 +270,7 @@ static void release_or_clear(object_user_defined_t *uobj, bool deep_cleaning) {
  * @param obj The object whose reference count is to be incremented.
  */
 static void inc_ref(object_t *obj) {
-    object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    assert(uobj->state != ZOMBIE);
-    uobj->refs++;
+    obj->refs++;
 }
 
 /**
@@ -204,129 +278,89 @@ static void inc_ref(object_t *obj) {
  * @param obj The object whose reference count is to be decremented.
  */
 static void dec_ref(object_t *obj) {
-    object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    assert(uobj->state != ZOMBIE);
-    if (!(--uobj->refs)) {
-        release_or_clear(uobj, true);
+    if (!(--obj->refs)) {
+        destroy((object_user_defined_t *)obj, true);
+    } else {
+        add_possible_root((cyclic_object_t *)obj);
     }
 }
 
 /**
- * @brief Marks the key-value pair in the user-defined object's children for garbage collection.
+ * @brief Pushes the values of the properties and the prototypes of an object onto a stack.
  * 
- * This function is called for each key-value pair in the AVL tree of a user-defined object. 
- * It marks both the key and the value of the pair, indicating that they are still in use 
- * and should not be collected by the garbage collector. Marking is typically part of 
- * the garbage collection process to ensure objects are properly retained as long as they 
- * are reachable.
+ * The keys belong to the shape and are marked together with the shape tree of the process.
  * 
- * @param unused Unused parameter, included for compatibility with the AVL tree traversal function.
- * @param key The key of the key-value pair, cast to an object. 
- *  This key is marked for garbage collection.
- * @param value The value of the key-value pair.  This value is also marked.
+ * @param obj The user-defined object.
+ * @param stack The stack that receives the children.
  */
-static void mark_child_pair(void *unused, void *key, value_t value) {
-    object_t *key_obj = (object_t *)key;
-    property_value_t *ref = (property_value_t *)value.ptr;
-    mark_object(key_obj);
-    mark_object(ref->object);
+static void push_children(object_t *obj, object_stack_t *stack) {
+    object_user_defined_t *uobj = (object_user_defined_t *)obj;
+    for (size_t index = 0; index < uobj->shape->count; index++) {
+        push_object_onto_stack(stack, uobj->values[index]);
+    }
+    for (size_t index = 0; index < uobj->proto_count; index++) {
+        push_object_onto_stack(stack, uobj->proto[index]);
+    }
 }
 
 /**
  * @brief Marks an object as reachable during garbage collection.
+ * 
+ * The children of an object marked for the first time are pushed onto the work stack of
+ * the garbage collector, which marks them later; the marking does not recurse.
+ * 
  * @param obj The object to mark as reachable.
  */
 static void mark(object_t *obj) {
-    object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    assert(uobj->state != ZOMBIE);
-    if (uobj->state == UNMARKED) {
-        uobj->state = MARKED;
-        avl_tree_for_each(uobj->properties, mark_child_pair, NULL);
-        for (size_t index = 0; index < uobj->proto->size; index++) {
-            mark_object((object_t*)uobj->proto->data[index]);
-        }
+    if (mark_slot(obj)) {
+        push_children(obj, get_object_process(obj)->gc_stack);
     }
 }
 
 /**
- * @brief Sweeps the object, cleaning it up or moving it to the object pool.
+ * @brief Sweeps the object (destroying it).
  * @param obj The object to sweep.
- * @return true if the object was either destroyed or moved to object pool (ZOMBIE),
- *         false if the object was marked (still alive) and shouldn't be processed.
- */
-static bool sweep(object_t *obj) {
-    object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    assert(uobj->state != ZOMBIE);
-    if (uobj->state == UNMARKED) {
-        release_or_clear(uobj, false);
-        return true;
-    } else {
-        uobj->state = UNMARKED;
-        return false;
-    }
-}
-
-/**
- * @brief Clearing the memory occupied by properties.
- * 
- * This function is called for each key-value pair in the AVL tree of a user-defined object. 
- * The memory occupied by the value is cleared.
- * 
- * @param unused Unused parameter, included for compatibility with the AVL tree traversal function.
- * @param key The key of the key-value pair, cast to an object.
- * @param value The value of the key-value pair, stored as a `value_t` type.
  */
-static void clear_properties(void *unused, void *key, value_t value) {
-    property_value_t *ref = (property_value_t *)value.ptr;
-    FREE(ref);
+static void sweep(object_t *obj) {
+    destroy((object_user_defined_t *)obj, false);
 }
 
 /**
- * @brief Releases a user-defined object.
+ * @brief Releases a user-defined object; its slot is freed together with the heap.
  * @param obj The object to release.
  */
 static void release(object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    remove_object_from_list(
-        uobj->state == ZOMBIE ? &obj->process->user_defined_objects : &obj->process->objects, obj
-    );
-    destroy_vector(uobj->proto);
-    destroy_vector(uobj->topology);
-    destroy_vector(uobj->keys);
-    avl_tree_for_each(uobj->properties, clear_properties, NULL);
-    destroy_avl_tree(uobj->properties);
-    FREE(obj);
+    release_topologies(uobj);
+    free_prototypes(uobj);
+    free_values(uobj);
 }
 
 /**
- * @brief Copies a key-value pair from one AVL tree to another during object cloning.
- * 
- * This function is used when cloning a user-defined object. It performs the following steps:
- * 1. Increments the reference count of both the key and the value.
- * 2. Adds the key to the `keys` vector of the target object.
- * 3. Inserts the key-value pair into the target object's `properties` AVL tree.
- * 
- * @param data A pointer to the target user-defined object being cloned.
- * @param key The key of the key-value pair to be cloned.
- * @param value The value of the key-value pair to be cloned.
+ * @brief Makes sure that the values array of an object can hold the given number of values.
+ * @param uobj The user-defined object.
+ * @param count The required number of values.
  */
-static void copy_child_pair(void *data, void *key, value_t value) {
-    object_user_defined_t *copy = (object_user_defined_t *)data;
-    property_value_t *ref = (property_value_t *)value.ptr;
-    INCREF(key);
-    INCREF(ref->object);
-    append_to_vector(copy->keys, key);
-    property_value_t *copy_ref = (property_value_t *)ALLOC(sizeof(property_value_t));
-    memcpy(copy_ref, ref, sizeof(property_value_t));
-    set_in_avl_tree(copy->properties, key, (value_t){ .ptr = copy_ref });
+static void reserve_values(object_user_defined_t *uobj, size_t count) {
+    if (count <= uobj->capacity) {
+        return;
+    }
+    size_t capacity = uobj->capacity * 2;
+    if (capacity < count) {
+        capacity = count;
+    }
+    object_t **values = (object_t **)ALLOC(capacity * sizeof(object_t *));
+    memcpy(values, uobj->values, uobj->shape->count * sizeof(object_t *));
+    free_values(uobj);
+    uobj->values = values;
+    uobj->capacity = capacity;
 }
 
 /**
  * @brief Clones a user-defined object.
  * 
- * This function creates a copy of the given user-defined object. All key-value pairs 
- * in the original object's children AVL tree are copied into the new object's AVL tree. 
- * The reference count of each key and value is incremented.
+ * This function creates a copy of the given user-defined object. The copy gets the same
+ * shape and a copy of the values array. The reference count of each value is incremented.
  * 
  * @param process The process that will own the cloned object.
  * @param obj The user-defined object to be cloned.
@@ -334,42 +368,50 @@ static void copy_child_pair(void *data, void *key, value_t value) {
  */
 static object_t *clone(process_t *process, object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    object_user_defined_t *copy = create_empty_user_defined_object(
+    uobj->topology->refs++;
+    object_user_defined_t *copy = create_empty_user_defined_object_ex(
         process,
-        (object_array_t){ (object_t *const *)uobj->proto->data, uobj->proto->size }
+        (object_array_t){ uobj->proto, uobj->proto_count },
+        uobj->topology
     );
-    avl_tree_for_each(uobj->properties, copy_child_pair, copy);
+    size_t count = uobj->shape->count;
+    reserve_values(copy, count);
+    for (size_t index = 0; index < count; index++) {
+        object_t *value = uobj->values[index];
+        INCREF(value);
+        copy->values[index] = value;
+    }
+    copy->shape = uobj->shape;
     return &copy->base;
 }
 
 /**
- * @brief Converts a key-value pair into a Goat notation string and appends it to the string
- *  builder.
- * 
- * This function processes a single key-value pair from the children of a user-defined object. 
- * It converts both the key and the value to their Goat notation string representations using 
- * their respective `to_string_notation` methods. The resulting key-value pair is appended to 
- * the provided string builder in the format `"key=value"`. If the builder already contains data, 
- * a semicolon is inserted before appending the new pair.
- * 
- * @param data A pointer to the `string_builder_t` used for constructing the string.
- * @param key The key of the key-value pair, cast to an object.
- * @param value The value of the key-value pair, stored as a `value_t` type.
+ * @struct property_pair_t
+ * @brief A key and a value of a property, used to print properties in the order of keys.
  */
-static void child_pair_to_string(void *data, void *key, value_t value) {
-    string_builder_t *builder = (string_builder_t *)data;
-    if (builder->length > 1) {
-        append_char(builder, ',');
-    }
-    object_t *key_obj = (object_t *)key;
-    property_value_t *ref = (property_value_t *)value.ptr;
-    string_value_t key_str = convert_object_to_string_notation(key_obj);
-    append_string_value(builder, key_str);
-    FREE_STRING(key_str);
-    append_char(builder, ':');
-    string_value_t value_str = convert_object_to_string_notation(ref->object);
-    append_string_value(builder, value_str);
-    FREE_STRING(value_str);
+typedef struct {
+    /**
+     * @brief The key of the property.
+     */
+    object_t *key;
+
+    /**
+     * @brief The value of the property.
+     */
+    object_t *value;
+} property_pair_t;
+
+/**
+ * @brief Compares two properties by their keys, for `qsort`.
+ * @param first The first property.
+ * @param second The second property.
+ * @return A negative value, zero, or a positive value, as for `strcmp`.
+ */
+static int compare_property_pairs(const void *first, const void *second) {
+    return compare_property_keys(
+        ((const property_pair_t *)first)->key,
+        ((const property_pair_t *)second)->key
+    );
 }
 
 /**
@@ -377,8 +419,8 @@ static void child_pair_to_string(void *data, void *key, value_t value) {
  * 
  * This function generates a string representation of a user-defined object in Goat notation, 
  * where each child key-value pair is represented as `"key:value"`. The key-value pairs are 
- * separated by commas and enclosed in curly braces `{}`. The string is constructed dynamically 
- * and must be freed by the caller using `FREE`.
+ * sorted by keys, separated by commas and enclosed in curly braces `{}`. The string is
+ * constructed dynamically and must be freed by the caller using `FREE`.
 
  * @param obj The user-defined object to convert to a string in Goat notation.
  * @return A `string_value_t` structure containing the dynamically allocated string 
@@ -386,13 +428,32 @@ static void child_pair_to_string(void *data, void *key, value_t value) {
  */
 static string_value_t to_string_notation(const object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    if (uobj->properties->root == NULL) {
+    size_t count = uobj->shape->count;
+    if (count == 0) {
         return STATIC_STRING(L"{ }");
     }
+    property_pair_t *pairs = (property_pair_t *)ALLOC(count * sizeof(property_pair_t));
+    for (size_t index = 0; index < count; index++) {
+        pairs[index].key = uobj->shape->keys[index];
+        pairs[index].value = uobj->values[index];
+    }
+    qsort(pairs, count, sizeof(property_pair_t), compare_property_pairs);
     string_builder_t builder;
     init_string_builder(&builder, 2);
     append_char(&builder, '{');
-    avl_tree_for_each(uobj->properties, child_pair_to_string, &builder);
+    for (size_t index = 0; index < count; index++) {
+        if (index > 0) {
+            append_char(&builder, ',');
+        }
+        string_value_t key_str = convert_object_to_string_notation(pairs[index].key);
+        append_string_value(&builder, key_str);
+        FREE_STRING(key_str);
+        append_char(&builder, ':');
+        string_value_t value_str = convert_object_to_string_notation(pairs[index].value);
+        append_string_value(&builder, value_str);
+        FREE_STRING(value_str);
+    }
+    FREE(pairs);
     return append_char(&builder, '}');
 }
 
@@ -417,7 +478,7 @@ static string_value_t to_string(const object_t *obj) {
  */
 static object_array_t get_prototypes(const object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    return (object_array_t){ (object_t **)uobj->proto->data, uobj->proto->size };
+    return (object_array_t){ uobj->proto, uobj->proto_count };
 }
 
 /**
@@ -427,15 +488,14 @@ static object_array_t get_prototypes(const object_t *obj) {
  */
 static object_array_t get_topology(const object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    return (object_array_t){ (object_t **)uobj->topology->data, uobj->topology->size };
+    return (object_array_t){ uobj->topology->items, uobj->topology->size };
 }
 
 /**
  * @brief Retrieves all property keys from a user-defined object.
  * 
- * This implementation of `get_keys` for user-defined objects returns an array containing
- * references to all keys stored in the object's `keys` vector. The size of the array is
- * determined by the number of keys currently in the vector.
+ * This implementation of `get_keys` for user-defined objects returns the keys stored
+ * in the shape of the object, in the order the properties were created.
  * 
  * @param obj The user-defined object from which to retrieve the keys.
  * @return An `object_array_t` containing pointers to all property keys and the total 
@@ -443,14 +503,14 @@ static object_array_t get_topology(const object_t *obj) {
  */
 static object_array_t get_keys(const object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    return (object_array_t){ (object_t *const *)uobj->keys->data, uobj->keys->size };
+    return (object_array_t){ (object_t *const *)uobj->shape->keys, uobj->shape->count };
 }
 
 /**
  * @brief Retrieves a property value from a user-defined object.
  * 
- * This function looks up the specified `key` in the `children` collection of the user-defined
- * object. If the key exists, the corresponding value is returned. If the key does not exist,
+ * This function looks up the specified `key` in the shape of the user-defined object.
+ * If the key exists, the corresponding value is returned. If the key does not exist,
  * `NULL` is returned.
  * 
  * @param obj The user-defined object from which the property is being retrieved.
@@ -459,8 +519,8 @@ static object_array_t get_keys(const object_t *obj) {
  */
 static object_t *get_property(const object_t *obj, const object_t *key) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    property_value_t *ref = (property_value_t *)(get_from_avl_tree(uobj->properties, key).ptr);
-    return ref ? ref->object : NULL;
+    size_t index = find_property_in_shape(uobj->shape, key);
+    return index != SIZE_MAX ? uobj->values[index] : NULL;
 }
 
 /**
@@ -468,7 +528,7 @@ static object_t *get_property(const object_t *obj, const object_t *key) {
  * 
  * This function adds a new property to a user-defined object with the specified key and value.
  * The property can be marked as constant (immutable). If a property with the same key already
- * exists, the function will fail.
+ * exists, the function will fail. The object moves to the child shape that has the new key.
  * 
  * @param obj The user-defined object to which the property is being set.
  * @param key The key for the property.
@@ -479,17 +539,34 @@ static object_t *get_property(const object_t *obj, const object_t *key) {
 static model_status_t create_property(object_t *obj, object_t *key, object_t *value,
         bool constant) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    property_value_t *ref = (property_value_t *)(get_from_avl_tree(uobj->properties, key).ptr);
-    if (ref) {
+    if (find_property_in_shape(uobj->shape, key) != SIZE_MAX) {
         return MSTAT_PROPERTY_ALREADY_EXISTS;
     }
-    INCREF(key);
+    if (uobj->is_prototype) {
+        get_object_process(obj)->prototype_epoch++;
+    }
+    size_t index = uobj->shape->count;
+    reserve_values(uobj, index + 1);
+    INCREF(value);
+    uobj->values[index] = value;
+    uobj->shape = add_property_to_shape(uobj->shape, key, constant);
+    return MSTAT_OK;
+}
+
+/**
+ * @brief Replaces the value of the property under the given index.
+ * @param uobj The user-defined object.
+ * @param index The index of the property.
+ * @param value The new value.
+ * @return Status of the operation performed.
+ */
+static model_status_t replace_value(object_user_defined_t *uobj, size_t index, object_t *value) {
+    if (uobj->shape->constant[index]) {
+        return MSTAT_PROPERTY_IS_CONSTANT;
+    }
+    DECREF(uobj->values[index]);
+    uobj->values[index] = value;
     INCREF(value);
-    append_to_vector(uobj->keys, key);
-    ref = (property_value_t*)ALLOC(sizeof(property_value_t));
-    ref->object = value;
-    ref->is_constant = constant;
-    set_in_avl_tree(uobj->properties, key, (value_t){ .ptr = ref });
     return MSTAT_OK;
 }
 
@@ -506,17 +583,52 @@ static model_status_t create_property(object_t *obj, object_t *key, object_t *va
  */
 static model_status_t set_property(object_t *obj, object_t *key, object_t *value) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    property_value_t *ref = (property_value_t *)(get_from_avl_tree(uobj->properties, key).ptr);
-    if (!ref) {
+    size_t index = find_property_in_shape(uobj->shape, key);
+    if (index == SIZE_MAX) {
         return MSTAT_PROPERTY_NOT_FOUND;
     }
-    if (ref->is_constant) {
-        return MSTAT_PROPERTY_IS_CONSTANT;
+    return replace_value(uobj, index, value);
+}
+
+/**
+ * @brief Retrieves a property value from a user-defined object by the property index.
+ * 
+ * Properties are indexed in the order of their creation. The lookup succeeds only if
+ * the property under the given index has exactly the expected key.
+ * 
+ * @param obj The user-defined object from which the property is being retrieved.
+ * @param index The index of the property.
+ * @param key The expected key of the property.
+ * @return A pointer to the value of the property, or NULL if the property under this index
+ *  does not exist or has another key.
+ */
+static object_t *get_property_by_index(const object_t *obj, size_t index, const object_t *key) {
+    object_user_defined_t *uobj = (object_user_defined_t *)obj;
+    if (index >= uobj->shape->count || uobj->shape->keys[index] != key) {
+        return NULL;
     }
-    DECREF(ref->object);
-    ref->object = value;
-    INCREF(value);
-    return MSTAT_OK;
+    return uobj->values[index];
+}
+
+/**
+ * @brief Sets a property value in a user-defined object by the property index.
+ * 
+ * Works like `set_property()`, but does not search the shape: the property is taken
+ * by its index and is only checked to have the expected key.
+ * 
+ * @param obj The user-defined object to which the property is being set.
+ * @param index The index of the property.
+ * @param key The expected key of the property.
+ * @param value The value to associate with the key.
+ * @return Status of the operation performed.
+ */
+static model_status_t set_property_by_index(object_t *obj, size_t index, const object_t *key,
+        object_t *value) {
+    object_user_defined_t *uobj = (object_user_defined_t *)obj;
+    if (index >= uobj->shape->count || uobj->shape->keys[index] != key) {
+        return MSTAT_PROPERTY_NOT_FOUND;
+    }
+    return replace_value(uobj, index, value);
 }
 
 /**
@@ -597,7 +709,7 @@ static object_t *power(process_t *process, object_t *obj1, object_t *obj2) {
 
 static bool get_boolean_value(const object_t *obj) {
     object_user_defined_t *uobj = (object_user_defined_t *)obj;
-    return uobj->properties->root != NULL;
+    return uobj->shape->count > 0;
 }
 
 /**
@@ -610,6 +722,7 @@ static object_vtbl_t vtbl = {
     .dec_ref = dec_ref,
     .mark = mark,
     .sweep = sweep,
+    .push_children = push_children,
     .release = release,
     .compare = compare_object_addresses,
     .clone = clone,
@@ -621,6 +734,8 @@ static object_vtbl_t vtbl = {
     .get_property = get_property,
     .create_property = create_property,
     .set_property = set_property,
+    .get_property_by_index = get_property_by_index,
+    .set_property_by_index = set_property_by_index,
     .add = add,
     .subtract = subtract,
     .multiply = multiply,
@@ -639,32 +754,6 @@ static object_vtbl_t vtbl = {
     .call = stub_call
 };
 
-/**
- * @brief Compares two keys for use in the user-defined object's AVL tree.
- * 
- * This comparator is used to order keys in the AVL tree of a user-defined object. Keys are first
- * compared by their type (using `vtbl->type`). If the types are equal, the objects are compared
- * using their type-specific `compare` function.
- * 
- * @param first The first key to compare.
- * @param second The second key to compare.
- * @return An integer indicating the result of the comparison:
- *         - `1` if `first` is greater than `second`.
- *         - `-1` if `first` is less than `second`.
- *         - `0` if `first` and `second` are equal.
- */
-static int key_comparator(const void *first, const void *second) {
-    object_t *obj1 = (object_t *)first;
-    object_t *obj2 = (object_t *)second;
-    if (obj1->vtbl->type > obj2->vtbl->type) {
-        return 1;
-    } else if (obj1->vtbl->type < obj2->vtbl->type) {
-        return -1;
-    } else {
-        return compare_objects_using_vtbl(obj1, obj2);
-    }
-}
-
 /**
  * @brief Recursively performs a topological sorting of an object's prototype chain.
  * 
@@ -698,66 +787,98 @@ static void topological_sorting(object_t *obj, avl_tree_t *processed, vector_t *
  * This function creates the topological sorting for an object's prototype chain, handling both
  * single and multiple inheritance. If the object has multiple prototypes (i.e., multiple
  * inheritance), it performs a depth-first traversal for each prototype and ensures that the order
- * respects the inheritance hierarchy. For single inheritance, it directly appends the object and
- * its prototypes to the topology (it's faster).
+ * respects the inheritance hierarchy. For single inheritance, the topology is the prototype
+ * followed by its own topology (it's faster).
  * 
  * @param proto An array of prototypes that should be sorted in topological order.
- * @param topology A pointer to the vector that will store the resulting topological order.
+ * @return A new topology with one reference.
  */
-static void build_topology(object_array_t proto, vector_t *topology) {
-    assert(topology->size == 0);
-    size_t index;
+static topology_t *build_topology(object_array_t proto) {
+    topology_t *topology;
     if (proto.size > 1) {
         // multiple inheritance
+        vector_t *sorted = create_vector();
         avl_tree_t *processed = create_avl_tree(
             (int (*)(const void *, const void *))compare_object_addresses
         );
-        index = proto.size;
+        size_t index = proto.size;
         do {
             index--;
-            topological_sorting(proto.items[index], processed, topology);
+            topological_sorting(proto.items[index], processed, sorted);
         } while (index > 0);
         destroy_avl_tree(processed);
-        reverse_vector(topology);
+        reverse_vector(sorted);
+        topology = create_topology(sorted->size);
+        memcpy(topology->items, sorted->data, sorted->size * sizeof(object_t *));
+        destroy_vector(sorted);
     } else {
         // single prototype
         object_t *single = proto.items[0];
-        append_to_vector(topology, single);
         object_array_t parents = get_object_topology(single);
-        for (index = 0; index < parents.size; index++) {
-            append_to_vector(topology, parents.items[index]);
-        }        
+        topology = create_topology(parents.size + 1);
+        topology->items[0] = single;
+        if (parents.size > 0) {
+            memcpy(topology->items + 1, parents.items, parents.size * sizeof(object_t *));
+        }
     }
+    return topology;
 }
 
-static object_user_defined_t *create_empty_user_defined_object(process_t* process,
-        object_array_t proto) {
-    assert(proto.size > 0);
-    object_user_defined_t *uobj;
-    if (process->user_defined_objects.size > 0) {
-        uobj = (object_user_defined_t *)remove_first_object_from_list(
-            &process->user_defined_objects
-        );
-    } else {
-        uobj = (object_user_defined_t *)CALLOC(sizeof(object_user_defined_t));
-        uobj->base.vtbl = &vtbl;
-        uobj->base.process = process;
-        uobj->proto = create_vector_ex(proto.size);
-        uobj->topology = create_vector();
-        uobj->keys = create_vector();
-        uobj->properties = create_avl_tree(key_comparator);
+/**
+ * @brief Returns the topology of objects created from a prototype list.
+ * 
+ * If the only prototype is a user-defined object, the topology is taken from the cache of that
+ * prototype, so creating an object (in particular, a context, whose prototype is the parent
+ * context) costs neither a graph sort nor an allocation. The cache can not become stale: the
+ * prototypes of an object never change, and the cache is dropped when the prototype dies.
+ * 
+ * @param proto An array of prototypes.
+ * @return The topology, with a reference owned by the caller.
+ */
+static topology_t *get_topology_for_prototypes(object_array_t proto) {
+    if (proto.size == 1 && get_object_vtbl(proto.items[0]) == &vtbl) {
+        object_user_defined_t *single = (object_user_defined_t *)proto.items[0];
+        if (single->derived_topology == NULL) {
+            single->derived_topology = build_topology(proto);
+        }
+        single->derived_topology->refs++;
+        return single->derived_topology;
     }
-    uobj->refs = 1;
-    uobj->state = UNMARKED;
+    return build_topology(proto);
+}
+
+static object_user_defined_t *create_empty_user_defined_object_ex(process_t* process,
+        object_array_t proto, topology_t *topology) {
+    assert(proto.size > 0);
+    object_user_defined_t *uobj = (object_user_defined_t *)allocate_object(&process->heap,
+        &vtbl, sizeof(object_user_defined_t));
+    uobj->root_index = 0;
+    uobj->is_prototype = false;
+    uobj->proto = proto.size == 1 ? &uobj->inline_proto
+        : (object_t **)ALLOC(proto.size * sizeof(object_t *));
+    uobj->proto_count = proto.size;
     for (size_t index = 0; index < proto.size; index++) {
-        INCREF(proto.items[index]);
-        append_to_vector(uobj->proto, proto.items[index]);
+        object_t *item = proto.items[index];
+        INCREF(item);
+        uobj->proto[index] = item;
+        if (get_object_vtbl(item) == &vtbl) {
+            ((object_user_defined_t *)item)->is_prototype = true;
+        }
     }
-    build_topology(proto, uobj->topology);
-    add_object_to_list(&process->objects, &uobj->base);
+    uobj->topology = topology;
+    uobj->derived_topology = NULL;
+    uobj->shape = process->empty_shape;
+    uobj->values = uobj->inline_values;
+    uobj->capacity = INLINE_PROPERTY_COUNT;
     return uobj;
 }
 
+static object_user_defined_t *create_empty_user_defined_object(process_t* process,
+        object_array_t proto) {
+    assert(proto.size > 0);
+    return create_empty_user_defined_object_ex(process, proto, get_topology_for_prototypes(proto));
+}
+
 object_t *create_user_defined_object(process_t* process, object_array_t prototypes) {
     return &create_empty_user_defined_object(process, prototypes)->base;
 }
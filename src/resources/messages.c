@@ -30,6 +30,11 @@ static messages_t english = {
         L"  --print-bytecode              Print generated bytecode\n"
         L"  --print-source-code           Print regenerated Goat source code\n"
         L"  --print-graph <file.png|svg>  Generate AST graph image\n"
+        L"  --gc-threshold <count>        Set the minimum number of live objects that starts\n"
+        L"                                garbage collection during execution (0 disables it)\n"
+        L"  --time-slice <count>          Set the number of instructions a thread executes\n"
+        L"                                before the next thread gets control\n"
+        L"  --gc-stats                    Print garbage collector statistics\n"
         L"  -l, --lang, --language <lang> Select message language\n"
         L"  -w, --enable-warnings         Enable compiler warnings\n"
         L"  -h, --help, /?                Show this help message\n",
@@ -38,6 +43,9 @@ static messages_t english = {
     .unknown_option = L"Unknown option: '%a'",
     .missing_specification = L"Missing value for parameter '%a'",
     .bad_graph_file = L"The graph image file must be of type PNG or SVG",
+    .bad_gc_threshold = L"The garbage collection threshold must be a non-negative integer",
+    .bad_time_slice = L"The time slice must be a positive integer",
+    .gc_statistics = L"Garbage collections: %zu, cycle collections: %zu, objects freed: %zu, total pause: %zu us, maximum pause: %zu us",
     .no_graphviz = L"The GraphViz tool required for graph visualization is not installed on the system",
     .graphviz_failed = L"The GraphViz tool failed to generate a graph image",
     .duplicate_parameter = L"Duplicate parameter '%a' found",
@@ -86,6 +94,12 @@ static messages_t russian = {
         L"  --print-bytecode              Вывести сгенерированный байткод\n"
         L"  --print-source-code           Вывести восстановленный исходный код Goat\n"
         L"  --print-graph <file.png|svg>  Сгенерировать изображение AST-графа\n"
+        L"  --gc-threshold <количество>   Задать минимальное число живых объектов, при котором\n"
+        L"                                запускается сборка мусора во время выполнения\n"
+        L"                                (0 отключает ее)\n"
+        L"  --time-slice <количество>     Задать число инструкций, которое выполняет поток,\n"
+        L"                                прежде чем управление получит следующий поток\n"
+        L"  --gc-stats                    Вывести статистику сборщика мусора\n"
         L"  -l, --lang, --language <lang> Выбрать язык сообщений\n"
         L"  -w, --enable-warnings         Включить предупреждения компилятора\n"
         L"  -h, --help, /?                Показать эту справку\n",
@@ -94,6 +108,9 @@ static messages_t russian = {
     .unknown_option = L"Неизвестный параметр командной строки: '%a'",
     .missing_specification = L"Отсутствует значение для параметра '%a'",
     .bad_graph_file = L"Файл, в который сохраняется изображение графа, должен быть типа PNG или SVG",
+    .bad_gc_threshold = L"Порог сборки мусора должен быть неотрицательным целым числом",
+    .bad_time_slice = L"Квант времени должен быть положительным целым числом",
+    .gc_statistics = L"Сборок мусора: %zu, сборок циклов: %zu, освобождено объектов: %zu, общая пауза: %zu мкс, наибольшая пауза: %zu мкс",
     .no_graphviz = L"Утилита GraphViz, необходимая для генерации изображения графа, не установлена в системе",
     .graphviz_failed = L"Утилита GraphViz не смогла сгенерировать изображение графа",
     .duplicate_parameter = L"Параметр '%a' повторяется",
@@ -27,6 +27,9 @@ typedef struct {
     const wchar_t const *unknown_option;
     const wchar_t const *missing_specification;
     const wchar_t const *bad_graph_file;
+    const wchar_t const *bad_gc_threshold;
+    const wchar_t const *bad_time_slice;
+    const wchar_t const *gc_statistics;
     const wchar_t const *no_graphviz;
     const wchar_t const *graphviz_failed;
     const wchar_t const *duplicate_parameter;
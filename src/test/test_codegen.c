@@ -12,6 +12,7 @@
 #include "codegen/code_builder.h"
 #include "codegen/data_builder.h"
 #include "codegen/linker.h"
+#include "codegen/peephole.h"
 
 bool test_data_builder() {
     data_builder_t *builder = create_data_builder();
@@ -54,3 +55,101 @@ bool test_linker() {
     free_bytecode(code);
     return true;
 }
+
+bool test_peephole_optimization() {
+    code_builder_t *code = create_code_builder();
+    add_instruction(code, (instruction_t){ .opcode = ARG, .arg1 = 7 });
+    add_instruction(code, (instruction_t){ .opcode = FUNC });
+    add_instruction(code, (instruction_t){ .opcode = NIL });
+    add_instruction(code, (instruction_t){ .opcode = VAR, .arg1 = 1 });
+    add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = 5 });
+    add_instruction(code, (instruction_t){ .opcode = JIF, .arg1 = 6 });
+    add_instruction(code, (instruction_t){ .opcode = END });
+    // function body
+    add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = 2 });
+    add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = 1 });
+    add_instruction(code, (instruction_t){ .opcode = JNLT, .arg1 = 11 });
+    add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = 3 });
+    add_instruction(code, (instruction_t){ .opcode = ADD });
+    add_instruction(code, (instruction_t){ .opcode = RET });
+    apply_peephole_optimization(code);
+    ASSERT(code->size == 11);
+    ASSERT(code->instructions[0].arg1 == 6);
+    ASSERT(code->instructions[2].opcode == VARNIL);
+    ASSERT(code->instructions[2].arg1 == 1);
+    ASSERT(code->instructions[3].opcode == ILOAD32);
+    ASSERT(code->instructions[4].opcode == JIF);
+    ASSERT(code->instructions[4].arg1 == 5);
+    ASSERT(code->instructions[5].opcode == END);
+    ASSERT(code->instructions[6].opcode == ILOAD32);
+    ASSERT(code->instructions[7].opcode == JNLTI);
+    ASSERT(code->instructions[7].arg0 == 1);
+    ASSERT(code->instructions[7].arg1 == 9);
+    ASSERT(code->instructions[8].opcode == ILOAD32);
+    ASSERT(code->instructions[9].opcode == ADD);
+    destroy_code_builder(code);
+    return true;
+}
+
+bool test_peephole_known_call() {
+    code_builder_t *code = create_code_builder();
+    add_instruction(code, (instruction_t){ .opcode = NIL });
+    add_instruction(code, (instruction_t){ .opcode = VAR, .arg1 = 0 });
+    add_instruction(code, (instruction_t){ .opcode = ARG, .arg1 = 7 });
+    add_instruction(code, (instruction_t){ .opcode = FUNC });
+    add_instruction(code, (instruction_t){ .opcode = ILOAD32, .arg1 = 1 });
+    add_instruction(code, (instruction_t){ .opcode = CALLK, .arg0 = 1, .arg1 = 3 });
+    add_instruction(code, (instruction_t){ .opcode = END });
+    // function body
+    add_instruction(code, (instruction_t){ .opcode = LLOAD });
+    add_instruction(code, (instruction_t){ .opcode = RET });
+    apply_peephole_optimization(code);
+    ASSERT(code->size == 8);
+    ASSERT(code->instructions[0].opcode == VARNIL);
+    ASSERT(code->instructions[1].opcode == ARG);
+    ASSERT(code->instructions[1].arg1 == 6);
+    ASSERT(code->instructions[2].opcode == FUNC);
+    ASSERT(code->instructions[4].opcode == CALLK);
+    ASSERT(code->instructions[4].arg1 == 2);
+    destroy_code_builder(code);
+    return true;
+}
+
+/**
+ * @def OPCODE_REFERENCE
+ * @brief Produces an entry of the table of opcodes and their references to other instructions.
+ */
+#define OPCODE_REFERENCE(name, reference) { name, reference },
+
+bool test_peephole_instruction_references() {
+    static const struct {
+        opcode_t opcode;
+        instruction_reference_t reference;
+    } opcodes[] = { FOR_EACH_OPCODE(OPCODE_REFERENCE) };
+    for (size_t index = 0; index < sizeof(opcodes) / sizeof(opcodes[0]); index++) {
+        ASSERT(opcodes[index].opcode == (opcode_t)index);
+        if (opcodes[index].reference == NOT_A_REFERENCE) {
+            continue;
+        }
+        // NIL and VAR are fused, so the referenced instruction moves one position up
+        code_builder_t *code = create_code_builder();
+        add_instruction(code, (instruction_t){ .opcode = NIL });
+        add_instruction(code, (instruction_t){ .opcode = VAR });
+        if (opcodes[index].reference == ENTRY_POINT_IN_ARG) {
+            add_instruction(code, (instruction_t){ .opcode = ARG, .arg1 = 5 });
+            add_instruction(code, (instruction_t){ .opcode = opcodes[index].opcode });
+        } else {
+            add_instruction(code, (instruction_t){ .opcode = opcodes[index].opcode, .arg1 = 5 });
+            add_instruction(code, (instruction_t){ .opcode = NOP });
+        }
+        add_instruction(code, (instruction_t){ .opcode = END });
+        add_instruction(code, (instruction_t){ .opcode = RET });
+        apply_peephole_optimization(code);
+        ASSERT(code->size == 5);
+        ASSERT(code->instructions[1].arg1 == 4);
+        destroy_code_builder(code);
+    }
+    return true;
+}
+
+#undef OPCODE_REFERENCE
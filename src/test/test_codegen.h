@@ -19,3 +19,24 @@ bool test_data_builder();
  * @return True if the test passes, false otherwise.
  */
 bool test_linker();
+
+/**
+ * @brief Tests the fusion of instructions into superinstructions and the renumbering of
+ *  jump targets.
+ * @return True if the test passes, false otherwise.
+ */
+bool test_peephole_optimization();
+
+/**
+ * @brief Tests that the peephole optimization renumbers the index of the `FUNC` instruction
+ *  stored in a `CALLK` instruction.
+ * @return True if the test passes, false otherwise.
+ */
+bool test_peephole_known_call();
+
+/**
+ * @brief Tests that the peephole optimization renumbers the instruction indexes of every opcode
+ *  that refers to other instructions according to the opcode list.
+ * @return True if the test passes, false otherwise.
+ */
+bool test_peephole_instruction_references();
@@ -37,19 +37,34 @@ static test_description_t test_list[] = {
 
     , { "boolean object", test_boolean_object }
     , { "integer object", test_integer_object }
+    , { "tagged integers", test_tagged_integers }
     , { "addition of two integers", test_addition_of_two_integers }
     , { "subtraction of two integers", test_subtraction_of_two_integers }
     , { "string concatenation", test_strings_concatenation }
     , { "properties", test_properties }
+    , { "shared shapes", test_shared_shapes }
+    , { "string interning", test_string_interning }
     , { "string topology", test_string_topology }
+    , { "shared topologies", test_shared_topologies }
+    , { "cycle collection", test_cycle_collection }
+    , { "release of cycle children", test_cycle_children_release }
+    , { "deep object graph", test_deep_object_graph }
+    , { "heap sweep", test_heap_sweep }
+    , { "object process", test_object_process }
     , { "store and load", test_store_and_load }
+    , { "time slices", test_time_slices }
     , { "'sign' function", test_sign_function }
+    , { "native function registration", test_native_function_registration }
     , { "context cloning", test_context_cloning }
     , { "function definition", test_function_definition }
     , { "closure", test_closure }
+    , { "local variable slots", test_local_variable_slots }
 
     , { "data builder", test_data_builder }
     , { "linker", test_linker }
+    , { "peephole optimization", test_peephole_optimization }
+    , { "peephole optimization of known calls", test_peephole_known_call }
+    , { "instruction references", test_peephole_instruction_references }
 };
 
 int get_number_of_tests() {
@@ -11,10 +11,13 @@
 #include "model/object.h"
 #include "model/process.h"
 #include "model/thread.h"
+#include "model/context.h"
 #include "codegen/linker.h"
 #include "vm/vm.h"
+#include "vm/gc.h"
 #include "lib/allocate.h"
 #include "lib/split64.h"
+#include "lib/string_ext.h"
 
 /**
  * @brief Creates a test bytecode sequence.
@@ -57,6 +60,28 @@ bool test_integer_object() {
     return true;
 }
 
+bool test_tagged_integers() {
+    process_t *process = create_process();
+    size_t object_count = process->heap.object_count;
+    object_t *small = create_integer_object(process, -1000000000000);
+    ASSERT(is_tagged_integer(small));
+    ASSERT(get_object_integer_value(small).value == -1000000000000);
+    ASSERT(process->heap.object_count == object_count);
+    object_t *large = create_integer_object(process, INT64_MAX);
+    ASSERT(!is_tagged_integer(large));
+    ASSERT(get_object_integer_value(large).value == INT64_MAX);
+    object_t *boundary = create_integer_object(process, TAGGED_INTEGER_MAX);
+    ASSERT(is_tagged_integer(boundary));
+    object_t *sum = add_objects(process, boundary, get_static_integer_object(1));
+    ASSERT(!is_tagged_integer(sum));
+    ASSERT(get_object_integer_value(sum).value == (int64_t)TAGGED_INTEGER_MAX + 1);
+    ASSERT(compare_objects_using_vtbl(small, create_integer_object(process, -1000000000000)) == 0);
+    DECREF(sum);
+    DECREF(large);
+    destroy_process(process);
+    return true;
+}
+
 bool test_addition_of_two_integers() {
     instruction_t list[] = {
         { .opcode = ILOAD32, .arg1 = 2 },
@@ -182,6 +207,55 @@ bool test_properties() {
     return true;
 }
 
+bool test_shared_shapes() {
+    process_t *process = create_process();
+    object_t *root_object = get_root_object();
+    const wchar_t *names[] = { L"a", L"b", L"c", L"d", L"e", L"f" };
+    object_t *first = create_user_defined_object(process, (object_array_t){&root_object, 1});
+    object_t *second = create_user_defined_object(process, (object_array_t){&root_object, 1});
+    object_t *third = create_user_defined_object(process, (object_array_t){&root_object, 1});
+    for (size_t index = 0; index < 6; index++) {
+        object_t *value = create_integer_object(process, index);
+        ASSERT(create_object_property(first,
+            create_string_object(process, STATIC_STRING(names[index])), value, false) == MSTAT_OK);
+        ASSERT(create_object_property(second,
+            create_string_object(process, STATIC_STRING(names[index])), value, false) == MSTAT_OK);
+        ASSERT(create_object_property(third,
+            create_string_object(process, STATIC_STRING(names[5 - index])), value, false) == MSTAT_OK);
+    }
+    ASSERT(get_object_keys(first).items == get_object_keys(second).items);
+    ASSERT(get_object_keys(first).items != get_object_keys(third).items);
+    object_t *key = create_string_object(process, STATIC_STRING(L"e"));
+    ASSERT(create_object_property(second, key, key, false) == MSTAT_PROPERTY_ALREADY_EXISTS);
+    ASSERT(set_object_property(second, key, key) == MSTAT_OK);
+    ASSERT(get_object_property(second, key) == key);
+    ASSERT(get_object_integer_value(get_object_property(first, key)).value == 4);
+    ASSERT(get_object_integer_value(get_object_property(third, key)).value == 1);
+    const wchar_t *expected = L"{\"a\":0,\"b\":1,\"c\":2,\"d\":3,\"e\":4,\"f\":5}";
+    string_value_t str = convert_object_to_string(first);
+    ASSERT(0 == wcscmp(str.data, expected));
+    FREE_STRING(str);
+    destroy_process(process);
+    return true;
+}
+
+bool test_string_interning() {
+    process_t *process = create_process();
+    object_t *first = intern_string(process, STATIC_STRING(L"key"));
+    object_t *second = intern_string(process, (string_value_t){ WSTRDUP(L"key"), 3, true });
+    ASSERT(first == second);
+    ASSERT(is_interned_string(first));
+    ASSERT(intern_string(process, STATIC_STRING(L"print")) == get_string_print());
+    ASSERT(is_interned_string(get_string_print()));
+    object_t *dynamic = create_string_object(process, STATIC_STRING(L"key"));
+    ASSERT(!is_interned_string(dynamic));
+    ASSERT(compare_objects_using_vtbl(first, dynamic) == 0);
+    object_t *length = get_object_property(first, get_string_length());
+    ASSERT(length != NULL && get_object_integer_value(length).value == 3);
+    destroy_process(process);
+    return true;
+}
+
 bool test_string_topology() {
     process_t *process = create_process();
     object_t *obj = create_string_object(process, STATIC_STRING(L"test"));
@@ -195,6 +269,173 @@ bool test_string_topology() {
     return true;    
 }
 
+bool test_shared_topologies() {
+    process_t *process = create_process();
+    object_t *parent = process->main_thread->context->data;
+    object_t *first = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    object_t *second = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    object_array_t first_topology = get_object_topology(first);
+    object_array_t second_topology = get_object_topology(second);
+    ASSERT(first_topology.items == second_topology.items);
+    ASSERT(first_topology.size == get_object_topology(parent).size + 1);
+    ASSERT(first_topology.items[0] == parent);
+    object_t *copy = clone_object(process, first);
+    ASSERT(get_object_topology(copy).items == first_topology.items);
+    DECREF(first);
+    DECREF(copy);
+    object_t *third = create_user_defined_object(process, (object_array_t){ &second, 1 });
+    object_array_t third_topology = get_object_topology(third);
+    ASSERT(third_topology.size == second_topology.size + 1);
+    ASSERT(third_topology.items[0] == second && third_topology.items[1] == parent);
+    DECREF(third);
+    DECREF(second);
+    destroy_process(process);
+    return true;
+}
+
+bool test_cycle_collection() {
+    process_t *process = create_process();
+    object_t *parent = process->main_thread->context->data;
+    object_t *key = create_string_object(process, STATIC_STRING(L"other"));
+    object_t *child_key = create_string_object(process, STATIC_STRING(L"child"));
+    object_t *child = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    size_t object_count = process->heap.object_count;
+    object_t *first = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    object_t *second = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    ASSERT(create_object_property(first, key, second, false) == MSTAT_OK);
+    ASSERT(create_object_property(second, key, first, false) == MSTAT_OK);
+    ASSERT(create_object_property(first, child_key, child, false) == MSTAT_OK);
+    DECREF(first);
+    DECREF(second);
+    ASSERT(process->heap.object_count == object_count + 2);
+    collect_cycles(process);
+    ASSERT(process->heap.object_count == object_count);
+    ASSERT(process->possible_roots->size == 0);
+    ASSERT(process->gc_statistics.cycle_collections == 1);
+    ASSERT(process->gc_statistics.freed_objects == 2);
+    DECREF(child);
+    ASSERT(process->heap.object_count == object_count - 1);
+    DECREF(child_key);
+    DECREF(key);
+    destroy_process(process);
+    return true;
+}
+
+bool test_cycle_children_release() {
+    process_t *process = create_process();
+    object_t *parent = process->main_thread->context->data;
+    object_t *key = create_string_object(process, STATIC_STRING(L"other"));
+    object_t *text_key = create_string_object(process, STATIC_STRING(L"text"));
+    size_t object_count = process->heap.object_count;
+    object_t *first = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    object_t *second = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    object_t *text = create_string_object(process, STATIC_STRING(L"held by the cycle"));
+    ASSERT(create_object_property(first, key, second, false) == MSTAT_OK);
+    ASSERT(create_object_property(second, key, first, false) == MSTAT_OK);
+    ASSERT(create_object_property(first, text_key, text, false) == MSTAT_OK);
+    DECREF(text);
+    DECREF(first);
+    DECREF(second);
+    ASSERT(process->heap.object_count == object_count + 3);
+    collect_cycles(process);
+    ASSERT(process->heap.object_count == object_count);
+    ASSERT(process->gc_statistics.freed_objects == 3);
+    DECREF(text_key);
+    DECREF(key);
+    destroy_process(process);
+    return true;
+}
+
+bool test_deep_object_graph() {
+    const size_t length = 200000;
+    process_t *process = create_process();
+    object_t *parent = process->main_thread->context->data;
+    object_t *key = create_string_object(process, STATIC_STRING(L"next"));
+    size_t object_count = process->heap.object_count;
+    object_t *head = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+    object_t *last = head;
+    INCREF(last);
+    for (size_t index = 1; index < length; index++) {
+        object_t *item = create_user_defined_object(process, (object_array_t){ &parent, 1 });
+        ASSERT(create_object_property(last, key, item, false) == MSTAT_OK);
+        DECREF(last);
+        last = item;
+    }
+    push_object_onto_stack(process->main_thread->data_stack, head);
+    collect_garbage(process);
+    ASSERT(process->heap.object_count == object_count + length);
+    ASSERT(create_object_property(last, key, head, false) == MSTAT_OK);
+    DECREF(last);
+    DECREF(pop_object_from_stack(process->main_thread->data_stack));
+    ASSERT(process->heap.object_count == object_count + length);
+    collect_cycles(process);
+    ASSERT(process->heap.object_count == object_count);
+    DECREF(key);
+    destroy_process(process);
+    return true;
+}
+
+/**
+ * @brief Counts the spare slabs of a heap.
+ * @param heap The heap.
+ * @return The number of spare slabs.
+ */
+static size_t count_spare_slabs(const heap_t *heap) {
+    size_t count = 0;
+    for (const slab_t *slab = heap->spare_slabs; slab != NULL; slab = slab->next) {
+        count++;
+    }
+    return count;
+}
+
+bool test_heap_sweep() {
+    const size_t count = 3000;
+    process_t *process = create_process();
+    object_stack_t *stack = process->main_thread->data_stack;
+    size_t object_count = process->heap.object_count;
+    for (size_t index = 0; index < count; index++) {
+        object_t *obj = create_real_number_object(process, index + 0.5);
+        if (index % 2 == 0) {
+            push_object_onto_stack(stack, obj);
+        }
+    }
+    ASSERT(process->heap.object_count == object_count + count);
+    collect_garbage(process);
+    ASSERT(process->heap.object_count == object_count + count / 2);
+    object_t *obj = create_real_number_object(process, 0.25);
+    ASSERT(process->heap.object_count == object_count + count / 2 + 1);
+    DECREF(obj);
+    for (size_t index = 0; index < count / 2; index++) {
+        DECREF(pop_object_from_stack(stack));
+    }
+    ASSERT(process->heap.object_count == object_count);
+    size_t spare_slabs = count_spare_slabs(&process->heap);
+    collect_garbage(process);
+    ASSERT(count_spare_slabs(&process->heap) > spare_slabs);
+    destroy_process(process);
+    return true;
+}
+
+bool test_object_process() {
+    process_t *first = create_process();
+    process_t *second = create_process();
+    object_t *number = create_real_number_object(first, 1.5);
+    object_t *string = create_string_object(second, STATIC_STRING(L"text"));
+    object_t *copy = clone_object(first, string);
+    ASSERT(get_object_process(number) == first);
+    ASSERT(get_object_process(string) == second);
+    ASSERT(get_object_process(copy) == first);
+    ASSERT(get_object_process(first->main_thread->context->data) == first);
+    ASSERT(get_object_process(get_null_object()) == NULL);
+    ASSERT(get_object_process(intern_string(first, STATIC_STRING(L"key"))) == NULL);
+    DECREF(copy);
+    DECREF(string);
+    DECREF(number);
+    destroy_process(second);
+    destroy_process(first);
+    return true;
+}
+
 bool test_store_and_load() {
     data_builder_t *data_builder = create_data_builder();
     uint32_t name_idx = add_string_to_data_segment(data_builder, L"value");
@@ -219,6 +460,33 @@ bool test_store_and_load() {
     return true;
 }
 
+bool test_time_slices() {
+    const uint32_t length = 10;
+    code_builder_t *code_bulder = create_code_builder();
+    for (uint32_t index = 0; index < length; index++) {
+        add_instruction(code_bulder, (instruction_t){ .opcode = ILOAD32, .arg1 = index });
+    }
+    add_instruction(code_bulder, (instruction_t){ .opcode = END } );
+    data_builder_t *data_builder = create_data_builder();
+    bytecode_t *code = link_code_and_data(code_bulder, data_builder);
+    destroy_code_builder(code_bulder);
+    destroy_data_builder(data_builder);
+    for (uint32_t quantum = 3; quantum <= 4; quantum++) {
+        process_t *proc = create_process();
+        proc->time_slice = quantum;
+        thread_t *second = create_thread(proc, create_context(proc, get_root_context(), NULL));
+        run(proc, code);
+        // the threads take turns, so the second one has executed only whole time slices
+        // when the main thread reaches the end of the program
+        ASSERT(proc->main_thread->data_stack->size == length);
+        ASSERT(second->data_stack->size == length / quantum * quantum);
+        ASSERT(second->instr_id == length / quantum * quantum);
+        destroy_process(proc);
+    }
+    free_bytecode(code);
+    return true;
+}
+
 bool test_sign_function() {
     data_builder_t *data_builder = create_data_builder();
     uint32_t name_idx = add_string_to_data_segment(data_builder, L"sign");
@@ -242,6 +510,59 @@ bool test_sign_function() {
     return true;
 }
 
+/**
+ * @brief Native function used by the test: subtracts the second argument from the first one.
+ * @param args The arguments.
+ * @param thread The thread executing the function.
+ * @return The difference.
+ */
+static object_t *native_difference(native_arguments_t args, thread_t *thread) {
+    int64_t first = get_object_integer_value(get_native_argument(args, 0)).value;
+    int64_t second = get_object_integer_value(get_native_argument(args, 1)).value;
+    return create_integer_object(thread->process, first - second);
+}
+
+/**
+ * @brief Checks the native function registered by `test_native_function_registration`.
+ * @return `true` if the checks pass, `false` if any of them fails.
+ */
+static bool check_registered_native_function() {
+    ASSERT(!register_native_function(L"difference", native_difference));
+    ASSERT(!register_native_function(L"print", native_difference));
+    object_array_t keys = get_object_keys(get_root_context()->data);
+    ASSERT(!is_interned_string(keys.items[keys.size - 1]));
+    data_builder_t *data_builder = create_data_builder();
+    uint32_t name_idx = add_string_to_data_segment(data_builder, L"difference");
+    code_builder_t *code_bulder = create_code_builder();
+    add_instruction(code_bulder, (instruction_t){ .opcode = ILOAD32, .arg1 = 3 });
+    add_instruction(code_bulder, (instruction_t){ .opcode = ILOAD32, .arg1 = 10 });
+    add_instruction(code_bulder, (instruction_t){ .opcode = VLOAD, .arg1 = name_idx });
+    add_instruction(code_bulder, (instruction_t){ .opcode = CALL, .arg0 = 2 });
+    add_instruction(code_bulder, (instruction_t){ .opcode = END } );
+    bytecode_t *code = link_code_and_data(code_bulder, data_builder);
+    destroy_code_builder(code_bulder);
+    destroy_data_builder(data_builder);
+    process_t *proc = create_process();
+    run(proc, code);
+    ASSERT(proc->main_thread->data_stack->size == 1);
+    object_t *result = peek_object_from_stack(proc->main_thread->data_stack, 0);
+    int_value_t int_val = get_object_integer_value(result);
+    ASSERT(int_val.has_value);
+    ASSERT(int_val.value == 7);
+    destroy_process(proc);
+    free_bytecode(code);
+    return true;
+}
+
+bool test_native_function_registration() {
+    ASSERT(register_native_function(L"difference", native_difference));
+    // the registry is shared by all tests, so it is cleared even if a check fails
+    bool result = check_registered_native_function();
+    unregister_native_functions();
+    ASSERT(get_object_keys(get_root_context()->data).size == 5);
+    return result;
+}
+
 bool test_context_cloning() {
     data_builder_t *data_builder = create_data_builder();
     uint32_t name_x_idx = add_string_to_data_segment(data_builder, L"x");
@@ -338,3 +659,41 @@ bool test_closure() {
     free_bytecode(code);
     return true;
 }
+
+bool test_local_variable_slots() {
+    data_builder_t *data_builder = create_data_builder();
+    uint32_t name_x_idx = add_string_to_data_segment(data_builder, L"x");
+    uint32_t name_y_idx = add_string_to_data_segment(data_builder, L"y");
+    code_builder_t *code_bulder = create_code_builder();
+    add_instruction(code_bulder, (instruction_t){ .opcode = ILOAD32, .arg1 = 2 });
+    add_instruction(code_bulder, (instruction_t){ .opcode = VAR, .arg1 = name_x_idx });
+    add_instruction(code_bulder, (instruction_t){ .opcode = ILOAD32, .arg1 = 3 });
+    add_instruction(code_bulder, (instruction_t){ .opcode = VAR, .arg1 = name_y_idx });
+    add_instruction(code_bulder, (instruction_t){ .opcode = ENTER });
+    add_instruction(code_bulder, (instruction_t){ .opcode = ILOAD32, .arg1 = 5 });
+    add_instruction(code_bulder, (instruction_t){ .opcode = LSTORE, .flags = 1, .arg0 = 0,
+        .arg1 = name_x_idx });
+    add_instruction(code_bulder, (instruction_t){ .opcode = POP });
+    add_instruction(code_bulder, (instruction_t){ .opcode = LLOAD, .flags = 1, .arg0 = 0,
+        .arg1 = name_x_idx });
+    // wrong slot, the name must be found anyway
+    add_instruction(code_bulder, (instruction_t){ .opcode = LLOAD, .flags = 1, .arg0 = 0,
+        .arg1 = name_y_idx });
+    add_instruction(code_bulder, (instruction_t){ .opcode = MUL });
+    add_instruction(code_bulder, (instruction_t){ .opcode = LEAVE });
+    add_instruction(code_bulder, (instruction_t){ .opcode = POP });
+    add_instruction(code_bulder, (instruction_t){ .opcode = END } );
+    bytecode_t *code = link_code_and_data(code_bulder, data_builder);
+    destroy_code_builder(code_bulder);
+    destroy_data_builder(data_builder);
+    process_t *proc = create_process();
+    run(proc, code);
+    ASSERT(proc->main_thread->data_stack->size == 1);
+    object_t *result = peek_object_from_stack(proc->main_thread->data_stack, 0);
+    int_value_t int_val = get_object_integer_value(result);
+    ASSERT(int_val.has_value);
+    ASSERT(int_val.value == 15);
+    destroy_process(proc);
+    free_bytecode(code);
+    return true;
+}
@@ -20,6 +20,12 @@ bool test_boolean_object();
  */
 bool test_integer_object();
 
+/**
+ * @brief Tests that integers are unboxed into tagged pointers unless they are too large.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_tagged_integers();
+
 /**
  * @brief Tests addition of two integers in the virtual machine.
  * @return `true` if the test passes, `false` if it fails.
@@ -44,24 +50,91 @@ bool test_strings_concatenation();
  */
 bool test_properties();
 
+/**
+ * @brief Tests that user-defined objects built the same way share the same shape.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_shared_shapes();
+
+/**
+ * @brief Tests that strings with the same text are interned as the same object.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_string_interning();
+
 /**
  * @brief Gets the topology of the string object and the properties of its first prototype.
  * @return `true` if the test passes, `false` if it fails.
  */
 bool test_string_topology();
 
+/**
+ * @brief Checks that objects created from the same prototypes share one topology.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_shared_topologies();
+
+/**
+ * @brief Checks that the cycle collector frees a cycle of objects referenced only by each
+ *  other and keeps the objects referenced from outside.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_cycle_collection();
+
+/**
+ * @brief Checks that the cycle collector releases the acyclic objects (a string) referenced
+ *  only by a collected cycle.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_cycle_children_release();
+
+/**
+ * @brief Checks that both garbage collectors handle a long chain of objects without
+ *  recursion: the full collection keeps the chain, the cycle collector frees it once it
+ *  becomes a garbage cycle.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_deep_object_graph();
+
+/**
+ * @brief Checks that the sweep frees the unmarked objects of the heap, reuses their slots and
+ *  makes slabs left empty spare.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_heap_sweep();
+
+/**
+ * @brief Checks that the process owning an object is found through its slab, and that static
+ *  objects do not belong to any process.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_object_process();
+
 /**
  * @brief Tests the `STORE` and `VLOAD` opcodes by verifying data persistence and retrieval.
  * @return `true` if the test passes, `false` if it fails.
  */
 bool test_store_and_load();
 
+/**
+ * @brief Checks that the threads of a process take turns executing instructions, switching
+ *  at the boundaries of time slices.
+ * @return `true` if the test passes, `false` if it fails.
+ */
+bool test_time_slices();
+
 /**
  * @brief Tests the `CALL` opcode with the built-in `sign` function.
  * @return Returns `true` if the test passes, or `false` if it fails.
  */
 bool test_sign_function();
 
+/**
+ * @brief Registers a native function and calls it with the `CALL` opcode.
+ * @return Returns `true` if the test passes, or `false` if it fails.
+ */
+bool test_native_function_registration();
+
 /**
  * @brief Tests `ENTER` and `LEAVE` opcodes with execution of some code inside a new context.
  * @return Returns `true` if the test passes, or `false` if it fails.
@@ -80,3 +153,10 @@ bool test_function_definition();
  * @return Returns `true` if the test passes, or `false` if it fails.
  */
 bool test_closure();
+
+/**
+ * @brief Tests access to variables by (depth, slot), including the fallback to the lookup
+ *  by name when the slot holds another variable.
+ * @return Returns `true` if the test passes, or `false` if it fails.
+ */
+bool test_local_variable_slots();
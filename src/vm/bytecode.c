@@ -10,6 +10,7 @@
 #include "bytecode.h"
 #include "lib/allocate.h"
 #include "lib/string_ext.h"
+#include "lib/split64.h"
 
 /**
  * @brief Describes the properties of a bytecode instruction.
@@ -24,6 +25,8 @@ typedef struct {
     bool arg_1_is_unsigned_integer; /**< Indicates if `arg1` is an unsigned integer. */
     bool arg_1_is_signed_integer; /**< Indicates if `arg1` is a signed integer. */
     bool arg_1_is_string; /**< Indicates if `arg1` is a string reference. */
+    bool arg_1_is_integer; /**< Indicates if `arg1` is a reference to an integer constant. */
+    bool arg_1_is_real; /**< Indicates if `arg1` is a reference to a real number constant. */
 } instruction_descriptor_t;
 
 /**
@@ -47,27 +50,55 @@ static instruction_descriptor_t descriptors[] =
     , { .code = L"ILOAD64", .arg_1_is_unsigned_integer = true }
     , { .code = L"RLOAD", .arg_1_is_unsigned_integer = true }
     , { .code = L"SLOAD", .arg_1_is_string = true }
+    , { .code = L"ILOADK", .arg_1_is_integer = true }
+    , { .code = L"RLOADK", .arg_1_is_real = true }
     , { .code = L"VLOAD", .arg_1_is_string = true }
-    , { .code = L"VAR", .arg_1_is_string = true }
-    , { .code = L"CONST", .arg_1_is_string = true }
+    , { .code = L"VAR", .has_arg_0 = true, .arg_1_is_string = true }
+    , { .code = L"CONST", .has_arg_0 = true, .arg_1_is_string = true }
     , { .code = L"STORE", .arg_1_is_string = true }
-    , { .code = L"ADD" }
-    , { .code = L"SUB" }
-    , { .code = L"MUL" }
+    , { .code = L"LLOAD", .has_flags = true, .has_arg_0 = true, .arg_1_is_string = true }
+    , { .code = L"LSTORE", .has_flags = true, .has_arg_0 = true, .arg_1_is_string = true }
+    , { .code = L"ADD", .has_flags = true }
+    , { .code = L"SUB", .has_flags = true }
+    , { .code = L"MUL", .has_flags = true }
     , { .code = L"DIVIDE" }
     , { .code = L"MODULO" }
     , { .code = L"POWER" }
-    , { .code = L"LESS" }
+    , { .code = L"LESS", .has_flags = true }
     , { .code = L"LEQ" }
     , { .code = L"GREATER" }
     , { .code = L"GREQ" }
-    , { .code = L"EQUAL" }
+    , { .code = L"EQUAL", .has_flags = true }
     , { .code = L"DIFF" }
-    , { .code = L"FUNC", .has_arg_0 = true, .arg_1_is_unsigned_integer = true }
+    , { .code = L"IADD", .has_flags = true }
+    , { .code = L"ISUB", .has_flags = true }
+    , { .code = L"IMUL", .has_flags = true }
+    , { .code = L"ILESS", .has_flags = true }
+    , { .code = L"IEQUAL", .has_flags = true }
+    , { .code = L"RADD", .has_flags = true }
+    , { .code = L"RSUB", .has_flags = true }
+    , { .code = L"RMUL", .has_flags = true }
+    , { .code = L"RLESS", .has_flags = true }
+    , { .code = L"JNLT", .has_flags = true, .arg_1_is_unsigned_integer = true }
+    , { .code = L"IJNLT", .has_flags = true, .arg_1_is_unsigned_integer = true }
+    , { .code = L"ADDI", .has_flags = true, .arg_1_is_signed_integer = true }
+    , { .code = L"SUBI", .has_flags = true, .arg_1_is_signed_integer = true }
+    , { .code = L"JNLTI", .has_arg_0 = true, .arg_1_is_unsigned_integer = true }
+    , { .code = L"VARNIL", .has_arg_0 = true, .arg_1_is_string = true }
+    , { .code = L"LSTOREP", .has_flags = true, .has_arg_0 = true, .arg_1_is_string = true }
+    , { .code = L"FUNC", .has_flags = true, .has_arg_0 = true, .arg_1_is_unsigned_integer = true }
     , { .code = L"CALL", .has_arg_0 = true }
+    , { .code = L"CALLK", .has_arg_0 = true, .arg_1_is_unsigned_integer = true }
+    , { .code = L"TAILCALL", .has_arg_0 = true }
     , { .code = L"RET" }
     , { .code = L"ENTER" }
     , { .code = L"LEAVE" }
+    , { .code = L"ENTERF", .arg_1_is_unsigned_integer = true }
+    , { .code = L"LEAVEF" }
+    , { .code = L"PRINT" }
+    , { .code = L"SQRT" }
+    , { .code = L"SIGN" }
+    , { .code = L"ATAN2" }
 };
 
 /**
@@ -124,7 +155,7 @@ string_value_t bytecode_to_text(const bytecode_t *code) {
         // 3. flags
         if (descr.has_flags) {
             for (int bit = 7; bit >= 0; bit--) {
-                append_char(&builder, instr.flags | 1 << bit ? L'1' : L'0');
+                append_char(&builder, instr.flags & 1 << bit ? L'1' : L'0');
             }
             append_char(&builder, L' ');
         } else {
@@ -144,7 +175,8 @@ string_value_t bytecode_to_text(const bytecode_t *code) {
         }
 
         // 5. arg1
-        if (descr.arg_1_is_unsigned_integer || descr.arg_1_is_string) {
+        if (descr.arg_1_is_unsigned_integer || descr.arg_1_is_string
+                || descr.arg_1_is_integer || descr.arg_1_is_real) {
             string_value_t value = format_string(L"%zu", instr.arg1);
             string_value_t aligned = align_text(value, ARG1_COLUMN_SIZE - 1, ALIGN_RIGHT);
             append_string_value(&builder, aligned);
@@ -164,6 +196,15 @@ string_value_t bytecode_to_text(const bytecode_t *code) {
                 append_char(&builder, L' ');
                 append_string_value(&builder, str);
                 FREE_STRING(str);
+            } else if (descr.arg_1_is_integer || descr.arg_1_is_real) {
+                data_descriptor_t data = code->data_descriptors[instr.arg1];
+                split64_t s;
+                memcpy(&s, code->data + data.offset, sizeof(s));
+                string_value_t str = descr.arg_1_is_integer
+                    ? format_string(L" %li", s.int_value)
+                    : format_string(L" %f", s.real_value);
+                append_string_value(&builder, str);
+                FREE_STRING(str);
             }
         }
         else if (descr.arg_1_is_signed_integer) {
@@ -5,24 +5,46 @@
  * 
  * This file contains the implementation of garbage collection functions that allow the
  * Goat virtual machine to manage memory efficiently by cleaning up unreachable objects.
+ * 
+ * There are two collectors. The full one marks everything reachable from the roots and sweeps
+ * the rest of the heap. The cycle collector (synchronous trial deletion, as described by Bacon
+ * and Rajan) only looks at the objects reachable from the possible roots of garbage cycles:
+ * it subtracts the references between these objects from their reference counts, and the
+ * objects whose counts drop to zero are referenced only by one another, so they are garbage.
+ * Its pause depends on the number of possible roots, not on the size of the heap.
  */
 
+#include <time.h>
+
 #include "gc.h"
 #include "model/object.h"
+#include "model/cyclic_object.h"
 #include "model/thread.h"
 #include "model/context.h"
+#include "model/shape.h"
 
 /**
  * @brief Marks the objects on a thread's data stack and context data.
  * 
  * This function marks the objects on the thread's data stack as reachable, as well as the 
- * object associated with the thread's execution context. This helps in identifying the objects
- * that are still in use and ensures they are not collected during garbage collection.
+ * data objects of all contexts in the thread's context chain and the local variables of
+ * the frames (frames are not objects, so nothing else refers to their variables). Callers'
+ * contexts must be marked too: the data object of a context refers to the closure of
+ * the function, not to the caller.
+ * This helps in identifying the objects that are still in use and ensures they are not
+ * collected during garbage collection.
  * 
  * @param thread A pointer to the thread whose stack and context data are to be processed.
  */
 static void mark_objects_in_context_and_stack(thread_t *thread) {
-    mark_object(thread->context->data);
+    for (context_t *ctx = thread->context; ctx != NULL; ctx = ctx->previous) {
+        mark_object(ctx->data);
+        for (size_t index = 0; index < ctx->local_count; index++) {
+            if (ctx->locals[index] != NULL) {
+                mark_object(ctx->locals[index]);
+            }
+        }
+    }
     for (size_t index = 0; index < thread->data_stack->size; index++) {
         object_t *obj = thread->data_stack->objects[index];
         mark_object(obj);
@@ -32,52 +54,253 @@ static void mark_objects_in_context_and_stack(thread_t *thread) {
 /**
  * @brief Marks all reachable objects in the process.
  * 
- * This function iterates through the objects in the process and marks those that are reachable.
+ * This function marks the roots of the process. Marking an object for the first time pushes
+ * its children onto the work stack of the process; then the objects on the stack are marked
+ * until it is empty, so the depth of the object graph does not affect the native stack.
  * 
  * @param proc A pointer to the process whose objects will be marked.
  */
 static void mark_reachable_objects(process_t *proc) {
-    for (size_t index = 0; index < proc->string_cache_size; index++) {
-        mark_object(proc->string_cache[index]);
+    for (size_t index = 0; index < proc->constant_cache_size; index++) {
+        if (proc->constant_cache[index] != NULL) {
+            mark_object(proc->constant_cache[index]);
+        }
     }
+    mark_shape_tree(proc->empty_shape);
     thread_t *thread = proc->main_thread;
     do {
         mark_objects_in_context_and_stack(thread);
         thread = thread->next;
     } while (thread != proc->main_thread);
+    object_stack_t *stack = proc->gc_stack;
+    while (stack->size > 0) {
+        mark_object(stack->objects[--stack->size]);
+    }
 }
 
 /**
  * @brief Sweeps all unreachable objects in the process.
  * 
- * This function iterates through all objects in the process and frees those that are unmarked
- * (i.e., unreachable). These objects are no longer in use and can be safely deallocated.
+ * This function walks the bitmaps of the heap and frees the objects that are allocated but
+ * unmarked (i.e., unreachable). These objects are no longer in use and can be safely deallocated.
  * 
  * @param proc A pointer to the process whose objects will be swept.
  */
 static void sweep_unreachable_objects(process_t *proc) {
-    object_t *last_live = NULL;
-    object_t *obj = proc->objects.head;
-    while (obj != NULL) {
-        if (sweep_object(obj)) {
-            obj = last_live ? last_live->next : proc->objects.head;
-        } else {
-            last_live = obj;
-            obj = obj->next;
+    sweep_heap(&proc->heap);
+}
+
+/**
+ * @brief Forgets all possible roots of garbage cycles.
+ * @param proc A pointer to the process.
+ */
+static void clear_possible_roots(process_t *proc) {
+    vector_t *roots = proc->possible_roots;
+    for (size_t index = 0; index < roots->size; index++) {
+        cyclic_object_t *obj = (cyclic_object_t *)roots->data[index];
+        if (obj != NULL) {
+            obj->root_index = 0;
         }
     }
+    clear_vector(roots);
 }
 
 /**
- * @brief Performs garbage collection on the specified process.
- * 
- * The garbage collection process involves marking objects that are reachable and then sweeping
- * away the ones that are no longer referenced. The function will iterate through all objects in
- * the given process and clean up the memory by releasing unmarked objects.
- * 
- * @param proc A pointer to the process from which garbage will be collected.
+ * @brief Adds the results of a collection to the statistics of the process.
+ * @param proc A pointer to the process.
+ * @param start The time the collection started at.
+ * @param objects_before The number of live objects before the collection.
  */
+static void update_statistics(process_t *proc, clock_t start, size_t objects_before) {
+    size_t pause = (size_t)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+    gc_statistics_t *stat = &proc->gc_statistics;
+    stat->freed_objects += objects_before - proc->heap.object_count;
+    stat->total_pause += pause;
+    if (pause > stat->max_pause) {
+        stat->max_pause = pause;
+    }
+}
+
 void collect_garbage(process_t *proc) {
+    clock_t start = clock();
+    size_t objects_before = proc->heap.object_count;
     mark_reachable_objects(proc);
     sweep_unreachable_objects(proc);
+    clear_possible_roots(proc);
+    proc->gc_statistics.collections++;
+    update_statistics(proc, start, objects_before);
+    schedule_garbage_collection(proc);
+}
+
+void schedule_garbage_collection(process_t *proc) {
+    if (proc->gc_min_threshold == 0) {
+        proc->gc_threshold = SIZE_MAX;
+        return;
+    }
+    uint32_t growth = proc->gc_growth > 100 ? proc->gc_growth : 100;
+    size_t threshold = proc->heap.object_count * growth / 100;
+    proc->gc_threshold = threshold > proc->gc_min_threshold ? threshold : proc->gc_min_threshold;
+}
+
+/**
+ * @brief Marks an object and everything reachable from it gray, subtracting the references
+ *  between the marked objects from their reference counts.
+ * @param obj The object.
+ * @param stack The work stack; it is left as it was found.
+ */
+static void mark_gray(object_t *obj, object_stack_t *stack) {
+    if (obj->state == GRAY) {
+        return;
+    }
+    size_t base = stack->size;
+    obj->state = GRAY;
+    obj->vtbl->push_children(obj, stack);
+    while (stack->size > base) {
+        object_t *child = stack->objects[--stack->size];
+        if (is_cyclic_object(child)) {
+            child->refs--;
+            if (child->state != GRAY) {
+                child->state = GRAY;
+                child->vtbl->push_children(child, stack);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Marks a live object and everything reachable from it live again (`ALIVE`),
+ *  restoring the reference counts of the children.
+ * @param obj The object referenced from outside the gray subgraph.
+ * @param stack The work stack; it is left as it was found.
+ */
+static void scan_black(object_t *obj, object_stack_t *stack) {
+    size_t base = stack->size;
+    obj->state = ALIVE;
+    obj->vtbl->push_children(obj, stack);
+    while (stack->size > base) {
+        object_t *child = stack->objects[--stack->size];
+        if (is_cyclic_object(child)) {
+            child->refs++;
+            if (child->state != ALIVE) {
+                child->state = ALIVE;
+                child->vtbl->push_children(child, stack);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decides whether the gray objects reachable from an object are live or garbage.
+ * 
+ * An object whose reference count is still positive after the subtraction is referenced
+ * from outside, so it and everything reachable from it are live. An object whose count
+ * dropped to zero is white, until a live object referring to it is found.
+ * 
+ * @param obj The object.
+ * @param stack The work stack; it is left as it was found.
+ */
+static void scan(object_t *obj, object_stack_t *stack) {
+    size_t base = stack->size;
+    push_object_onto_stack(stack, obj);
+    while (stack->size > base) {
+        obj = stack->objects[--stack->size];
+        if (!is_cyclic_object(obj)) {
+            continue;
+        }
+        if (obj->state == GRAY) {
+            if (obj->refs > 0) {
+                scan_black(obj, stack);
+            } else {
+                obj->state = WHITE;
+                obj->vtbl->push_children(obj, stack);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Adds a white object and all white objects reachable from it to the list of objects
+ *  to be destroyed.
+ * 
+ * The objects are destroyed only when the whole garbage has been collected, since they refer
+ * to one another.
+ * 
+ * @param obj The object.
+ * @param garbage The list of objects to be destroyed.
+ * @param stack The work stack; it is left as it was found.
+ */
+static void collect_white(object_t *obj, vector_t *garbage, object_stack_t *stack) {
+    size_t base = stack->size;
+    push_object_onto_stack(stack, obj);
+    while (stack->size > base) {
+        obj = stack->objects[--stack->size];
+        if (!is_cyclic_object(obj)) {
+            continue;
+        }
+        if (obj->state == WHITE) {
+            obj->state = ALIVE;
+            append_to_vector(garbage, obj);
+            obj->vtbl->push_children(obj, stack);
+        }
+    }
+}
+
+/**
+ * @brief Releases the references from the collected garbage to acyclic objects.
+ * 
+ * Sweeping destroys the garbage objects without touching their children. The references to
+ * the children that can be part of a cycle have already been subtracted by `mark_gray` and
+ * were only restored for the references coming from live objects, but acyclic children
+ * (strings, numbers) are not counted by the cycle collector, so their reference counts are
+ * decremented here, which destroys those referenced only by the garbage.
+ * 
+ * @param garbage The list of objects to be destroyed.
+ * @param stack The work stack; it is left as it was found.
+ */
+static void release_acyclic_children(vector_t *garbage, object_stack_t *stack) {
+    size_t base = stack->size;
+    for (size_t index = 0; index < garbage->size; index++) {
+        object_t *obj = (object_t *)garbage->data[index];
+        obj->vtbl->push_children(obj, stack);
+        while (stack->size > base) {
+            object_t *child = stack->objects[--stack->size];
+            if (!is_cyclic_object(child)) {
+                DECREF(child);
+            }
+        }
+    }
+}
+
+void collect_cycles(process_t *proc) {
+    clock_t start = clock();
+    size_t objects_before = proc->heap.object_count;
+    vector_t *roots = proc->possible_roots;
+    object_stack_t *stack = proc->gc_stack;
+    for (size_t index = 0; index < roots->size; index++) {
+        if (roots->data[index] != NULL) {
+            mark_gray((object_t *)roots->data[index], stack);
+        }
+    }
+    for (size_t index = 0; index < roots->size; index++) {
+        if (roots->data[index] != NULL) {
+            scan((object_t *)roots->data[index], stack);
+        }
+    }
+    vector_t *garbage = create_vector();
+    for (size_t index = 0; index < roots->size; index++) {
+        cyclic_object_t *obj = (cyclic_object_t *)roots->data[index];
+        if (obj != NULL) {
+            obj->root_index = 0;
+            collect_white(&obj->base, garbage, stack);
+        }
+    }
+    clear_vector(roots);
+    release_acyclic_children(garbage, stack);
+    // sweeping destroys the garbage objects without touching their children
+    for (size_t index = 0; index < garbage->size; index++) {
+        sweep_object((object_t *)garbage->data[index]);
+    }
+    destroy_vector(garbage);
+    proc->gc_statistics.cycle_collections++;
+    update_statistics(proc, start, objects_before);
 }
@@ -6,10 +6,19 @@
  * This file contains the necessary functions and definitions for garbage collection
  * in the Goat virtual machine. The garbage collection process ensures that unused objects are
  * properly cleaned up to avoid memory leaks.
+ * 
+ * Reference counting frees most objects as soon as they become unreachable, but it can not
+ * free cycles, such as a closure and the context it was created in. So the collector is also
+ * started during the execution, at safe points of the virtual machine, whenever the number of
+ * live objects reaches a threshold that grows together with the heap. Between the full
+ * collections, the cycle collector frees cycles that include objects whose reference counts
+ * were decremented recently.
  */
 
 #pragma once
 
+#include <stdint.h>
+
 #include "model/process.h"
 
 /**
@@ -22,3 +31,43 @@
  * @param proc A pointer to the process from which garbage will be collected.
  */
 void collect_garbage(process_t *proc);
+
+/**
+ * @brief Collects garbage cycles that include the possible roots recorded by the process.
+ * 
+ * Unlike `collect_garbage()`, this function does not look at the whole heap, only at
+ * the objects reachable from the possible roots, and frees those that are referenced only
+ * by one another. Afterwards the list of possible roots is empty.
+ * 
+ * @param proc A pointer to the process.
+ */
+void collect_cycles(process_t *proc);
+
+/**
+ * @brief Calculates the number of live objects at which the next collection is started.
+ * 
+ * The threshold is the number of objects currently alive multiplied by the growth factor
+ * of the process, but not less than its minimum threshold; a zero minimum threshold disables
+ * collections during the execution.
+ * 
+ * @param proc A pointer to the process.
+ */
+void schedule_garbage_collection(process_t *proc);
+
+/**
+ * @brief Performs garbage collection if the number of live objects has reached the threshold,
+ *  or cycle collection if enough possible roots of garbage cycles have been recorded.
+ * 
+ * Must only be called at a safe point, where every object in use is reachable from the roots
+ * (the data stacks, the contexts and the caches of the process), not only from local
+ * variables of the virtual machine.
+ * 
+ * @param proc A pointer to the process.
+ */
+static inline void collect_garbage_if_needed(process_t *proc) {
+    if (proc->heap.object_count >= proc->gc_threshold) {
+        collect_garbage(proc);
+    } else if (proc->possible_roots->size >= proc->cycle_threshold && proc->cycle_threshold > 0) {
+        collect_cycles(proc);
+    }
+}
@@ -146,6 +146,24 @@ typedef enum {
      */
     SLOAD, /**< Loads a static string onto the data stack. */
 
+    /**
+     * @brief Loads an integer constant from the data segment onto the data stack.
+     *
+     * The `arg1` field is the index of a data descriptor holding a 64-bit integer. The integer
+     * object is created on the first execution and cached in the process, so later executions
+     * push the same object without allocating. Used for values that do not fit into a tagged
+     * integer; smaller ones are loaded with `ILOAD32`.
+     */
+    ILOADK, /**< Loads an integer constant from the data segment. */
+
+    /**
+     * @brief Loads a real number constant from the data segment onto the data stack.
+     *
+     * The `arg1` field is the index of a data descriptor holding a double. Like `ILOADK`, the
+     * object is created once per process and then reused.
+     */
+    RLOADK, /**< Loads a real number constant from the data segment. */
+
     /**
      * @brief Loads the value of a variable from the current context onto the data stack.
      * 
@@ -164,6 +182,8 @@ typedef enum {
      * - If variable/constant exists in parent context: creates new binding in current context
      *   (shadowing)
      * - Otherwise: creates new variable in current context
+     * `arg1` is the name of the variable. If the current context is a frame, the variable is
+     * stored in the slot `arg0` instead (the slot must be empty).
      */
     VAR, /**< Declares a new mutable variable in current context. */
 
@@ -179,6 +199,7 @@ typedef enum {
      * Unlike variables declared with VAR, constants:
      * - Cannot be modified after creation (attempt throws exception)
      * - Can still be shadowed in child contexts
+     * The arguments are the same as for `VAR`.
      */
     CONST, /**< Declares a new immutable constant in current context. */
 
@@ -195,13 +216,38 @@ typedef enum {
      */
     STORE, /**< Stores to existing variable or creates new if not found. */
 
+    /**
+     * @brief Loads the value of a local variable, addressed by its slot, onto the data stack.
+     *
+     * The `LLOAD` opcode is a statically resolved form of `VLOAD`. The compiler knows in which
+     * enclosing context the variable is declared and in which order the variables of that
+     * context are created, so the variable is addressed by a pair (depth, slot):
+     * - `flags`: how many contexts up the prototype chain the variable lives (0 = current);
+     * - `arg0`: the index of the variable (slot) in that context;
+     * - `arg1`: the name of the variable (static string).
+     * The name is used as a guard: if the slot does not hold a variable with this name
+     * (for example, the declaration has not been executed yet), the instruction behaves
+     * exactly like `VLOAD`.
+     */
+    LLOAD, /**< Loads a local variable by (depth, slot), or falls back to `VLOAD`. */
+
+    /**
+     * @brief Stores a value to a local variable addressed by its slot.
+     *
+     * The `LSTORE` opcode is a statically resolved form of `STORE`; its arguments have the same
+     * meaning as for `LLOAD`. If the slot does not hold a mutable variable with the given name,
+     * the instruction behaves exactly like `STORE`.
+     */
+    LSTORE, /**< Stores to a local variable by (depth, slot), or falls back to `STORE`. */
+
     /**
      * @brief Adds the top two objects of the stack.
      *
      * The `ADD` opcode performs an addition operation on the two topmost objects on the data stack. 
      * It pops the top two objects, adds them, and then pushes the result back onto the stack. This 
      * operation can be used for both numerical and non-numerical objects, depending on the virtual 
-     * machine's behavior.
+     * machine's behavior. If the operands are numbers, the virtual machine quickens the instruction
+     * into `IADD` or `RADD` (the same goes for `SUB`, `MUL`, `LESS` and `EQUAL`).
      */
     ADD, /**< Adds the top two objects on the data stack. */
 
@@ -297,6 +343,142 @@ typedef enum {
      */
     DIFF, /**< Pushes `true` if top two objects are not equal. */
 
+    /**
+     * @brief Adds two integers.
+     *
+     * The `IADD` opcode is emitted instead of `ADD` when the static analysis has proven that both
+     * operands are integers. If both operands are indeed (tagged) integers, the sum is computed
+     * directly, without dispatching through the virtual tables; otherwise the instruction behaves
+     * exactly like `ADD`. If the `INTEGER_RESULT_FITS` flag is set, the ranges of the operands
+     * prove that the result fits into a tagged integer, so its range is not checked.
+     * The instruction also appears at run time, when a generic `ADD` is quickened.
+     */
+    IADD, /**< Adds two integers, or falls back to `ADD`. */
+
+    /**
+     * @brief Subtracts two integers.
+     *
+     * The integer form of `SUB`, see `IADD`.
+     */
+    ISUB, /**< Subtracts two integers, or falls back to `SUB`. */
+
+    /**
+     * @brief Multiplies two integers.
+     *
+     * The integer form of `MUL`, see `IADD`.
+     */
+    IMUL, /**< Multiplies two integers, or falls back to `MUL`. */
+
+    /**
+     * @brief Checks if the first integer is less than the second.
+     *
+     * The integer form of `LESS`: if both operands are (tagged) integers, they are compared
+     * directly; otherwise the instruction behaves exactly like `LESS`.
+     */
+    ILESS, /**< Compares two integers, or falls back to `LESS`. */
+
+    /**
+     * @brief Checks if two integers are equal.
+     *
+     * The integer form of `EQUAL`: if both operands are (tagged) integers, their
+     * representations are compared; otherwise the instruction behaves exactly like `EQUAL`.
+     * The compiler does not emit it, it appears only as a result of quickening.
+     */
+    IEQUAL, /**< Checks two integers for equality, or falls back to `EQUAL`. */
+
+    /**
+     * @brief Adds two real numbers.
+     *
+     * The `RADD` opcode is emitted instead of `ADD` when the static analysis has proven that
+     * the left operand is a real number and the right one is a real number or an integer.
+     * If it is so at run time, the sum is computed directly on `double` values; otherwise
+     * the instruction behaves exactly like `ADD`. The instruction also appears at run time,
+     * when a generic `ADD` is quickened.
+     */
+    RADD, /**< Adds two real numbers, or falls back to `ADD`. */
+
+    /**
+     * @brief Subtracts two real numbers.
+     *
+     * The real form of `SUB`, see `RADD`.
+     */
+    RSUB, /**< Subtracts two real numbers, or falls back to `SUB`. */
+
+    /**
+     * @brief Multiplies two real numbers.
+     *
+     * The real form of `MUL`, see `RADD`.
+     */
+    RMUL, /**< Multiplies two real numbers, or falls back to `MUL`. */
+
+    /**
+     * @brief Checks if the first real number is less than the second.
+     *
+     * The real form of `LESS`, see `RADD`.
+     */
+    RLESS, /**< Compares two real numbers, or falls back to `LESS`. */
+
+    /**
+     * @brief Compares two objects and jumps if the first one is not less than the second.
+     *
+     * The `JNLT` opcode is a fusion of `LESS` and `JIF`, emitted for conditions like
+     * `if (a < b)`: it pops the two topmost objects, and if the first one is not less
+     * than the second, execution continues from the target instruction index encoded
+     * in the instruction argument. No boolean object is pushed and popped in between.
+     */
+    JNLT, /**< Compares two objects, jumps if the first is not less. */
+
+    /**
+     * @brief Compares two integers and jumps if the first one is not less than the second.
+     *
+     * The integer form of `JNLT`, emitted when the static analysis has proven that both
+     * operands are integers, or produced by quickening. If the operands are not (tagged)
+     * integers, the instruction behaves exactly like `JNLT`.
+     */
+    IJNLT, /**< Compares two integers, jumps if the first is not less. */
+
+    /**
+     * @brief Adds an integer constant to the object on top of the stack.
+     *
+     * The `ADDI` opcode is a superinstruction replacing `ILOAD32` followed by `ADD` (or `IADD`):
+     * `arg1` is the signed 32-bit constant, `flags` are the flags of the addition. If the
+     * object is a (tagged) integer, the sum is computed directly; otherwise, the constant is
+     * added as `ADD` does.
+     */
+    ADDI, /**< Adds an integer constant to the top of the stack. */
+
+    /**
+     * @brief Subtracts an integer constant from the object on top of the stack.
+     *
+     * The `SUBI` opcode replaces `ILOAD32` followed by `SUB` (or `ISUB`), see `ADDI`.
+     */
+    SUBI, /**< Subtracts an integer constant from the top of the stack. */
+
+    /**
+     * @brief Compares the object on top of the stack with an integer constant and jumps
+     *  if the object is not less than the constant.
+     *
+     * The `JNLTI` opcode replaces `ILOAD32` followed by `JNLT` (or `IJNLT`): `arg0` is
+     * the constant as a signed 16-bit integer, `arg1` is the target instruction index.
+     */
+    JNLTI, /**< Compares the top of the stack with a constant, jumps if it is not less. */
+
+    /**
+     * @brief Declares a mutable variable initialized with `null`.
+     *
+     * The `VARNIL` opcode replaces `NIL` followed by `VAR`; the arguments are the same
+     * as for `VAR`.
+     */
+    VARNIL, /**< Declares a variable initialized with `null`. */
+
+    /**
+     * @brief Stores to a local variable and pops the value.
+     *
+     * The `LSTOREP` opcode replaces `LSTORE` followed by `POP`; the arguments are the same
+     * as for `LSTORE`.
+     */
+    LSTOREP, /**< Stores to a local variable, then pops the value off the data stack. */
+
     /**
      * @brief Creates a new function object.
      *
@@ -305,6 +487,9 @@ typedef enum {
      * 2. 32-bit reference to argument names array (in data segment)
      * 3. 32-bit entry point address (passed via ARG instruction)
      *
+     * If the `FUNCTION_IN_FRAME` flag is set, the function is executed in a frame; the
+     * array of argument names is then followed by the number of local variable slots.
+     *
      * Usage in bytecode always appears as an ARG+FUNC pair.
      */
     FUNC, /**< Creates a new function object. */
@@ -330,6 +515,32 @@ typedef enum {
      */
     CALL, /**< Calls a function with arguments from the data stack. */
 
+    /**
+     * @brief Calls a function whose definition is known at compile time.
+     *
+     * Emitted instead of `CALL` when the called object is a constant initialized with
+     * a function literal. The `arg0` field holds the number of arguments, and `arg1` is
+     * the index of the `FUNC` instruction that creates the function.
+     *
+     * If the object at the top of the stack was created by that `FUNC` instruction (it shares
+     * its template), the function is entered directly, with the closure of the object, without
+     * dispatching through the virtual table. Any other object is called like `CALL` does.
+     */
+    CALLK, /**< Calls a function created by a known FUNC instruction. */
+
+    /**
+     * @brief Calls a function in tail position.
+     *
+     * Works like `CALL`, but if the function is a user-defined one and the instruction
+     * is executed in the frame of a function, the frame is reused instead of creating a new one:
+     * the stack is unwound, the context gets the new arguments, and the callee returns directly
+     * to the caller of the current function. Deep recursion in tail position therefore runs in
+     * constant stack and context memory.
+     *
+     * Always followed by `RET`, which returns the result when the frame could not be reused.
+     */
+    TAILCALL, /**< Calls a function, reusing the current frame. */
+
     /**
      * @brief Returns from the current function.
      *
@@ -357,5 +568,179 @@ typedef enum {
      * context remains on the stack (unless explicitly popped), allowing it to be stored
      * for later use.
      */
-    LEAVE /**< Restores the parent context, leaving the current one on the stack. */
+    LEAVE, /**< Restores the parent context, leaving the current one on the stack. */
+
+    /**
+     * @brief Creates a new frame for a block.
+     *
+     * The `ENTERF` opcode is the form of `ENTER` used for blocks whose environment can not
+     * escape: it creates a frame with `arg1` local variable slots instead of an object.
+     * Name lookups from the frame go to the environment of the current context.
+     */
+    ENTERF, /**< Creates a new frame for a block. */
+
+    /**
+     * @brief Destroys the frame of a block.
+     *
+     * The `LEAVEF` opcode restores the previous context and pushes `null` as the value of
+     * the block, since a frame is not an object.
+     */
+    LEAVEF, /**< Destroys the current frame, pushes `null`. */
+
+    /**
+     * @brief Prints the object at the top of the stack.
+     *
+     * Intrinsic form of a call of the built-in `print` function with one argument, emitted when
+     * the name `print` is known to refer to the built-in function. The argument is replaced
+     * with `null`, the result of the call.
+     */
+    PRINT, /**< Prints the top object, replaces it with `null`. */
+
+    /**
+     * @brief Computes the square root of the number at the top of the stack.
+     *
+     * Intrinsic form of a call of the built-in `sqrt` function with one argument.
+     * The argument is replaced with the result.
+     */
+    SQRT, /**< Replaces the top number with its square root. */
+
+    /**
+     * @brief Computes the sign of the number at the top of the stack.
+     *
+     * Intrinsic form of a call of the built-in `sign` function with one argument.
+     * The argument is replaced with -1, 0 or 1.
+     */
+    SIGN, /**< Replaces the top number with its sign. */
+
+    /**
+     * @brief Computes the arc tangent of two numbers.
+     *
+     * Intrinsic form of a call of the built-in `atan` function with two arguments. Since
+     * arguments are pushed in reverse order, the top of the stack is the Y coordinate and
+     * the object below it is the X coordinate. Both are replaced with `atan2(y, x)`, or with
+     * `null` if any of them is not a number.
+     */
+    ATAN2 /**< Replaces two numbers (y on top, x below) with their arc tangent. */
 } opcode_t;
+
+/**
+ * @enum instruction_reference_t
+ * @brief Tells whether an instruction refers to another instruction by its index.
+ *
+ * Code that moves instructions, such as the peephole optimization, has to renumber these
+ * indexes, so every opcode declares its kind of reference in `FOR_EACH_OPCODE`.
+ */
+typedef enum {
+    NOT_A_REFERENCE, /**< The instruction does not refer to other instructions. */
+    INSTRUCTION_INDEX, /**< `arg1` is the index of an instruction. */
+    ENTRY_POINT_IN_ARG /**< The `ARG` instruction preceding this one holds an entry point. */
+} instruction_reference_t;
+
+/**
+ * @def FOR_EACH_OPCODE
+ * @brief Expands the given macro for every opcode, in the order of the `opcode_t` enumeration.
+ *
+ * The macro takes the opcode and its `instruction_reference_t`. Used to build the label
+ * table and the handlers of the threaded dispatch engine and the reference table of the
+ * peephole optimization, so they always stay in sync with the opcode list; a new opcode
+ * must be added here, together with the kind of its reference.
+ */
+#define FOR_EACH_OPCODE(X) \
+    X(NOP, NOT_A_REFERENCE) \
+    X(ARG, NOT_A_REFERENCE) \
+    X(END, NOT_A_REFERENCE) \
+    X(JUMP, INSTRUCTION_INDEX) \
+    X(JIF, INSTRUCTION_INDEX) \
+    X(POP, NOT_A_REFERENCE) \
+    X(NIL, NOT_A_REFERENCE) \
+    X(TRUE, NOT_A_REFERENCE) \
+    X(FALSE, NOT_A_REFERENCE) \
+    X(ILOAD32, NOT_A_REFERENCE) \
+    X(ILOAD64, NOT_A_REFERENCE) \
+    X(RLOAD, NOT_A_REFERENCE) \
+    X(SLOAD, NOT_A_REFERENCE) \
+    X(ILOADK, NOT_A_REFERENCE) \
+    X(RLOADK, NOT_A_REFERENCE) \
+    X(VLOAD, NOT_A_REFERENCE) \
+    X(VAR, NOT_A_REFERENCE) \
+    X(CONST, NOT_A_REFERENCE) \
+    X(STORE, NOT_A_REFERENCE) \
+    X(LLOAD, NOT_A_REFERENCE) \
+    X(LSTORE, NOT_A_REFERENCE) \
+    X(ADD, NOT_A_REFERENCE) \
+    X(SUB, NOT_A_REFERENCE) \
+    X(MUL, NOT_A_REFERENCE) \
+    X(DIVIDE, NOT_A_REFERENCE) \
+    X(MODULO, NOT_A_REFERENCE) \
+    X(POWER, NOT_A_REFERENCE) \
+    X(LESS, NOT_A_REFERENCE) \
+    X(LEQ, NOT_A_REFERENCE) \
+    X(GREATER, NOT_A_REFERENCE) \
+    X(GREQ, NOT_A_REFERENCE) \
+    X(EQUAL, NOT_A_REFERENCE) \
+    X(DIFF, NOT_A_REFERENCE) \
+    X(IADD, NOT_A_REFERENCE) \
+    X(ISUB, NOT_A_REFERENCE) \
+    X(IMUL, NOT_A_REFERENCE) \
+    X(ILESS, NOT_A_REFERENCE) \
+    X(IEQUAL, NOT_A_REFERENCE) \
+    X(RADD, NOT_A_REFERENCE) \
+    X(RSUB, NOT_A_REFERENCE) \
+    X(RMUL, NOT_A_REFERENCE) \
+    X(RLESS, NOT_A_REFERENCE) \
+    X(JNLT, INSTRUCTION_INDEX) \
+    X(IJNLT, INSTRUCTION_INDEX) \
+    X(ADDI, NOT_A_REFERENCE) \
+    X(SUBI, NOT_A_REFERENCE) \
+    X(JNLTI, INSTRUCTION_INDEX) \
+    X(VARNIL, NOT_A_REFERENCE) \
+    X(LSTOREP, NOT_A_REFERENCE) \
+    X(FUNC, ENTRY_POINT_IN_ARG) \
+    X(CALL, NOT_A_REFERENCE) \
+    X(CALLK, INSTRUCTION_INDEX) \
+    X(TAILCALL, NOT_A_REFERENCE) \
+    X(RET, NOT_A_REFERENCE) \
+    X(ENTER, NOT_A_REFERENCE) \
+    X(LEAVE, NOT_A_REFERENCE) \
+    X(ENTERF, NOT_A_REFERENCE) \
+    X(LEAVEF, NOT_A_REFERENCE) \
+    X(PRINT, NOT_A_REFERENCE) \
+    X(SQRT, NOT_A_REFERENCE) \
+    X(SIGN, NOT_A_REFERENCE) \
+    X(ATAN2, NOT_A_REFERENCE)
+
+/**
+ * @def INTEGER_RESULT_FITS
+ * @brief Flag of the integer arithmetic instructions (`IADD`, `ISUB`, `IMUL`): the result
+ *  is known to lie within [`-SMALL_INTEGER_LIMIT`, `SMALL_INTEGER_LIMIT`].
+ */
+#define INTEGER_RESULT_FITS 1
+
+/**
+ * @def SMALL_INTEGER_LIMIT
+ * @brief The largest magnitude of an integer that is representable as a tagged integer
+ *  on every supported platform (32-bit ones included).
+ */
+#define SMALL_INTEGER_LIMIT 0x3FFFFFFF
+
+/**
+ * @def INSTRUCTION_QUICKENED
+ * @brief Flag of the specialized arithmetic and comparison instructions: the instruction was
+ *  not emitted by the compiler, but rewritten at run time from the generic one, and turns back
+ *  into it when its guard fails.
+ */
+#define INSTRUCTION_QUICKENED 2
+
+/**
+ * @def INSTRUCTION_DEOPTIMIZED
+ * @brief Flag of the generic arithmetic and comparison instructions: the quickened form of
+ *  the instruction has failed, so it is not quickened again.
+ */
+#define INSTRUCTION_DEOPTIMIZED 4
+
+/**
+ * @def FUNCTION_IN_FRAME
+ * @brief Flag of the `FUNC` instruction: the environment of the function can not escape,
+ *  so the function is executed in a frame.
+ */
+#define FUNCTION_IN_FRAME 1
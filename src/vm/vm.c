@@ -5,16 +5,87 @@
  */
 
 #include <assert.h>
+#include <memory.h>
+#include <math.h>
 #include <stdbool.h>
 
 #include "vm.h"
 #include "gc.h"
+#include "model/object.h"
 #include "model/context.h"
 #include "model/thread.h"
+#include "model/function_template.h"
 #include "lib/allocate.h"
+#include "lib/io.h"
 #include "lib/avl_tree.h"
 #include "lib/split64.h"
 
+/**
+ * @def THREADED_DISPATCH
+ * @brief Enables the direct-threaded (computed goto) instruction dispatch.
+ * 
+ * Labels as values are a GCC extension (also supported by Clang), so the threaded dispatch
+ * is only available with these compilers. It can be turned off explicitly by defining
+ * `GOAT_NO_THREADED_DISPATCH`, in which case the portable table-driven loop is used.
+ */
+#if defined(__GNUC__) && !defined(GOAT_NO_THREADED_DISPATCH)
+#define THREADED_DISPATCH
+#endif
+
+/**
+ * @def INLINE_CACHE_WAYS
+ * @brief Number of entries in the inline cache of a single instruction.
+ * 
+ * A cache with one entry is monomorphic; with several entries it can remember lookups made
+ * from contexts with different prototypes (for example, from different closures).
+ */
+#define INLINE_CACHE_WAYS 2
+
+/**
+ * @struct inline_cache_entry_t
+ * @brief Remembered result of a lookup of a name through a prototype chain.
+ * 
+ * The lookup starts at the data object of the current context. The entry is valid if
+ * this object does not have the property itself, its (single) prototype is `proto`,
+ * and the prototype epoch of the process is still `epoch`: then the property is still
+ * found in `holder`, or is still not found at all if `holder` is `NULL`.
+ */
+typedef struct {
+    /**
+     * @brief The prototype of the object where the lookup started, or `NULL` for
+     *  an unused entry.
+     */
+    object_t *proto;
+
+    /**
+     * @brief The prototype epoch of the process at the moment of the lookup.
+     */
+    uint64_t epoch;
+
+    /**
+     * @brief The object in the prototype chain that has the property, or `NULL` if
+     *  the property was not found.
+     */
+    object_t *holder;
+
+    /**
+     * @brief The index of the property in the holder, or `SIZE_MAX` if the holder does not
+     *  support access to properties by index.
+     */
+    size_t index;
+} inline_cache_entry_t;
+
+/**
+ * @struct inline_cache_t
+ * @brief Inline cache of one instruction that looks up a name.
+ */
+typedef struct {
+    /**
+     * @brief Cache entries, the most recently added first.
+     */
+    inline_cache_entry_t entries[INLINE_CACHE_WAYS];
+} inline_cache_t;
+
 /**
  * @struct runtime_t
  * @brief Structure to represent the runtime environment for the Goat virtual machine.
@@ -28,6 +99,26 @@ typedef struct {
      * @brief Pointer to the bytecode being executed.
      */
     bytecode_t *code;
+
+    /**
+     * @brief Private copy of the instructions of the bytecode, which is actually executed.
+     * 
+     * Generic arithmetic and comparison instructions rewrite themselves in this copy into
+     * specialized ones (and back), depending on the operands they see; the bytecode itself
+     * is never modified.
+     */
+    instruction_t *instructions;
+
+    /**
+     * @brief Side table of inline caches, one per instruction, indexed by instruction id.
+     */
+    inline_cache_t *caches;
+
+    /**
+     * @brief Side table of function templates, indexed by the instruction id of
+     *  the `FUNC` instruction that uses the template.
+     */
+    function_template_t **templates;
 } runtime_t;
 
 /**
@@ -79,17 +170,213 @@ static object_t *get_property_from_object_or_its_prototypes(object_t *obj, objec
     return value;
 }
 
+/**
+ * @brief Finds the index of a property of an object by its key.
+ * 
+ * @param obj The object.
+ * @param key The key of the property.
+ * @return The index of the property, or `SIZE_MAX` if the object does not have such
+ *  a property or does not support access to properties by index.
+ */
+static size_t find_property_index(const object_t *obj, const object_t *key) {
+    object_array_t keys = get_object_keys(obj);
+    for (size_t index = 0; index < keys.size; index++) {
+        if (keys.items[index] == key) {
+            return get_object_property_by_index(obj, index, key) != NULL ? index : SIZE_MAX;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Finds the object in a prototype chain that has the property with the given key.
+ * 
+ * @param obj The object where the lookup starts.
+ * @param key The key of the property.
+ * @return The object itself or one of its prototypes, or `NULL` if the property was not found.
+ */
+static object_t *find_property_holder(object_t *obj, const object_t *key) {
+    if (get_object_property(obj, key) != NULL) {
+        return obj;
+    }
+    object_array_t topology = get_object_topology(obj);
+    for (size_t index = 0; index < topology.size; index++) {
+        if (get_object_property(topology.items[index], key) != NULL) {
+            return topology.items[index];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Looks up a name through a prototype chain using the inline cache of an instruction.
+ * 
+ * If the context object has the property itself, no cache is needed. Otherwise, if one of
+ * the cache entries is valid for the context object, the remembered result is returned.
+ * If not, the prototype chain is searched, and the result is stored in the cache,
+ * displacing the oldest entry.
+ * 
+ * @param cache The inline cache of the instruction.
+ * @param context The data object of the current context.
+ * @param key The name to look up.
+ * @param index Receives the index of the property in the holder, or `SIZE_MAX` if unknown.
+ * @return The object that has the property, or `NULL` if the property was not found.
+ */
+static object_t *lookup_with_cache(inline_cache_t *cache, object_t *context,
+        const object_t *key, size_t *index) {
+    *index = SIZE_MAX;
+    object_array_t proto = get_object_prototypes(context);
+    if (proto.size != 1 || get_object_property(context, key) != NULL) {
+        return find_property_holder(context, key);
+    }
+    uint64_t epoch = get_object_process(context)->prototype_epoch;
+    for (int way = 0; way < INLINE_CACHE_WAYS; way++) {
+        inline_cache_entry_t *entry = &cache->entries[way];
+        if (entry->proto == proto.items[0] && entry->epoch == epoch) {
+            *index = entry->index;
+            return entry->holder;
+        }
+    }
+    object_t *holder = find_property_holder(proto.items[0], key);
+    for (int way = INLINE_CACHE_WAYS - 1; way > 0; way--) {
+        cache->entries[way] = cache->entries[way - 1];
+    }
+    inline_cache_entry_t *entry = &cache->entries[0];
+    entry->proto = proto.items[0];
+    entry->epoch = epoch;
+    entry->holder = holder;
+    entry->index = holder ? find_property_index(holder, key) : SIZE_MAX;
+    *index = entry->index;
+    return holder;
+}
+
+/**
+ * @brief Stores a value to a variable, searching for it through the context chain.
+ * 
+ * The variable is searched for in the context object itself and then in its prototypes.
+ * If it is found and mutable, its value is replaced. Otherwise, a new mutable variable
+ * is created in the context object.
+ * 
+ * @param context The data object of the current context.
+ * @param key The name of the variable.
+ * @param value The value to store.
+ * @return `true` if the value was stored, `false` if the variable could not be created.
+ */
+static bool store_variable(object_t *context, object_t *key, object_t *value) {
+    bool changed = false;
+    model_status_t result = set_object_property(context, key, value);
+    assert(result != MSTAT_IMMUTABLE_OBJECT);
+    if (result == MSTAT_OK) {
+        changed = true;
+    }
+    else if (result == MSTAT_PROPERTY_NOT_FOUND) {
+        object_array_t proto = get_object_topology(context);
+        size_t index = 0;
+        do {
+            result = set_object_property(proto.items[index], key, value);
+            if (result == MSTAT_IMMUTABLE_OBJECT) {
+                break;
+            }
+            if (result == MSTAT_OK) {
+                changed = true;
+                break;
+            }
+            index++;
+        } while (index < proto.size);
+    }
+    if (!changed) {
+        result = create_object_property(context, key, value, false);
+        if (result != MSTAT_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the data object of an enclosing context.
+ * 
+ * Each context object has the data object of its enclosing context as the first prototype,
+ * so the enclosing contexts are reached by following first prototypes.
+ * 
+ * @param context The data object of the current context.
+ * @param depth How many levels up to go (0 means the current context).
+ * @return The data object of the enclosing context, or `NULL` if the chain is shorter.
+ */
+static object_t *get_enclosing_context(object_t *context, uint8_t depth) {
+    while (depth > 0) {
+        object_array_t proto = get_object_prototypes(context);
+        if (proto.size == 0) {
+            return NULL;
+        }
+        context = proto.items[0];
+        depth--;
+    }
+    return context;
+}
+
+/**
+ * @brief Resolves the address (depth, slot) of a local variable in a chain of frames.
+ * 
+ * Frames are not objects, so they are walked separately: the lexical parent of a block
+ * frame is the previous context, the lexical parent of a function frame is its closure.
+ * Once the walk leaves the frames, the rest of the chain consists of data objects.
+ * 
+ * @param ctx The current context.
+ * @param depth How many levels up to go (0 means the current context).
+ * @param slot The index of the variable.
+ * @param holder Receives the data object of the enclosing context if the address is not
+ *  in a frame, or `NULL`.
+ * @return A pointer to the slot of the variable if the address is in a frame, `NULL` otherwise.
+ */
+static object_t **resolve_local_variable(context_t *ctx, uint8_t depth, uint16_t slot,
+        object_t **holder) {
+    while (ctx->frame) {
+        if (depth == 0) {
+            *holder = NULL;
+            return slot < ctx->local_count ? &ctx->locals[slot] : NULL;
+        }
+        depth--;
+        if (ctx->ret_address != BAD_INSTR_INDEX) {
+            break; // a function frame, the closure follows
+        }
+        ctx = ctx->previous;
+    }
+    *holder = get_enclosing_context(ctx->data, depth);
+    return NULL;
+}
+
+/**
+ * @brief Declares a variable in a slot of a frame.
+ * @param ctx The frame.
+ * @param slot The index of the variable.
+ * @param value The value of the variable; the reference is transferred to the frame.
+ * @return `true` if the variable was declared, `false` if the slot does not exist or
+ *  the variable was already declared.
+ */
+static bool declare_local_variable(context_t *ctx, uint16_t slot, object_t *value) {
+    if (slot >= ctx->local_count || ctx->locals[slot] != NULL) {
+        return false;
+    }
+    ctx->locals[slot] = value;
+    return true;
+}
+
 /**
  * @brief Loads a string from the bytecode or retrieves it from the cache.
+ * 
+ * Strings are interned in the symbol table of the process, so the same text always
+ * produces the same object (including builtin names such as `print`).
+ * 
  * @param runtime The runtime environment containing the static data cache and bytecode.
  * @param string_id The identifier of the static string to load.
  * @return A pointer to the `object_t` representing the static string.
  */
 static object_t *load_string(runtime_t *runtime, process_t *process, uint32_t string_id) {
-    object_t *string = process->string_cache[string_id];
+    object_t *string = process->constant_cache[string_id];
     if (string == NULL) {
         data_descriptor_t descriptor = runtime->code->data_descriptors[string_id];
-        string = create_string_object(
+        string = intern_string(
             process,
             (string_value_t) {
                 (wchar_t*)(runtime->code->data + descriptor.offset),
@@ -97,7 +384,7 @@ static object_t *load_string(runtime_t *runtime, process_t *process, uint32_t st
                 false
             }
         );
-        process->string_cache[string_id] = string;
+        process->constant_cache[string_id] = string;
     }
     return string;
 }
@@ -352,6 +639,35 @@ static bool exec_RLOAD(runtime_t *runtime, instruction_t instr, thread_t *thread
     return true;
 }
 
+/**
+ * @brief Loads a numeric constant from the bytecode or retrieves it from the cache.
+ * 
+ * The constant is created once per process; the cache owns the reference to it.
+ * 
+ * @param runtime The runtime environment containing the bytecode.
+ * @param process The process that owns the cache.
+ * @param data_id The index of the data descriptor holding the constant.
+ * @param real `true` if the constant is a real number, `false` if it is an integer.
+ * @return A pointer to the object representing the constant, or `NULL` if the descriptor
+ *  does not hold an 8-byte value.
+ */
+static object_t *load_number(runtime_t *runtime, process_t *process, uint32_t data_id,
+        bool real) {
+    object_t *number = process->constant_cache[data_id];
+    if (number == NULL) {
+        data_descriptor_t descriptor = runtime->code->data_descriptors[data_id];
+        if (descriptor.size != sizeof(split64_t)) {
+            return NULL;
+        }
+        split64_t s;
+        memcpy(&s, runtime->code->data + descriptor.offset, sizeof(s));
+        number = real ? create_real_number_object(process, s.real_value)
+            : create_integer_object(process, s.int_value);
+        process->constant_cache[data_id] = number;
+    }
+    return number;
+}
+
 /**
  * @brief Executes the SLOAD opcode to load a static string into the stack.
  *
@@ -380,6 +696,56 @@ static bool exec_SLOAD(runtime_t *runtime, instruction_t instr, thread_t *thread
     return true;
 }
 
+/**
+ * @brief Executes the `ILOADK` instruction.
+ * 
+ * Pushes the integer constant stored in the data segment onto the data stack. The object
+ * is created on the first execution and reused afterwards, so no allocation happens.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute; `arg1` is the index of the data descriptor.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the constant was pushed, `false` if the bytecode is invalid.
+ */
+static bool exec_ILOADK(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (instr.arg1 >= runtime->code->data_descriptor_count) {
+        return false; // bad bytecode
+    }
+    object_t *number = load_number(runtime, thread->process, instr.arg1, false);
+    if (number == NULL) {
+        return false;
+    }
+    push_object_onto_stack(thread->data_stack, number);
+    INCREF(number);
+    thread->instr_id++;
+    return true;
+}
+
+/**
+ * @brief Executes the `RLOADK` instruction.
+ * 
+ * Pushes the real number constant stored in the data segment onto the data stack. Like
+ * `ILOADK`, the object is created once and then reused.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute; `arg1` is the index of the data descriptor.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the constant was pushed, `false` if the bytecode is invalid.
+ */
+static bool exec_RLOADK(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (instr.arg1 >= runtime->code->data_descriptor_count) {
+        return false; // bad bytecode
+    }
+    object_t *number = load_number(runtime, thread->process, instr.arg1, true);
+    if (number == NULL) {
+        return false;
+    }
+    push_object_onto_stack(thread->data_stack, number);
+    INCREF(number);
+    thread->instr_id++;
+    return true;
+}
+
 /**
  * @brief Executes the VLOAD opcode to load a variable value from the context.
  * 
@@ -388,6 +754,8 @@ static bool exec_SLOAD(runtime_t *runtime, instruction_t instr, thread_t *thread
  * the `string_id` from the context's data object. If the property does not exist, it loads 
  * `null` as a placeholder. The value is then pushed onto the stack.
  * 
+ * The search through the prototype chain is memoized in the inline cache of the instruction.
+ * 
  * @param runtime The runtime environment.
  * @param instr The instruction to execute.
  * @param thread Pointer to the thread that is executing the instruction.
@@ -400,7 +768,17 @@ static bool exec_VLOAD(runtime_t *runtime, instruction_t instr, thread_t *thread
         return false; // bad bytecode
     }
     object_t *key = load_string(runtime, thread->process, string_id);
-    object_t *value = get_property_from_object_or_its_prototypes(thread->context->data, key);
+    size_t index;
+    object_t *holder = lookup_with_cache(&runtime->caches[thread->instr_id],
+        thread->context->data, key, &index);
+    object_t *value = NULL;
+    if (holder != NULL) {
+        value = index != SIZE_MAX ? get_object_property_by_index(holder, index, key)
+            : get_object_property(holder, key);
+    }
+    if (value == NULL) {
+        value = get_null_object();
+    }
     push_object_onto_stack(thread->data_stack, value);
     INCREF(value);
     thread->instr_id++;
@@ -427,11 +805,18 @@ static bool exec_VAR(runtime_t *runtime, instruction_t instr, thread_t *thread)
     if (string_id >= runtime->code->data_descriptor_count) {
         return false; // bad bytecode
     }
-    object_t *key = load_string(runtime, thread->process, string_id);
     object_t *value = pop_object_from_stack(thread->data_stack);
     if (value == NULL) {
         return false; // empty stack
     }
+    if (thread->context->frame) {
+        if (!declare_local_variable(thread->context, instr.arg0, value)) {
+            return false; // already exists
+        }
+        thread->instr_id++;
+        return true;
+    }
+    object_t *key = load_string(runtime, thread->process, string_id);
     model_status_t result = create_object_property(thread->context->data, key, value, false);
     if (result != MSTAT_OK) {
         return false; // already exists
@@ -461,11 +846,18 @@ static bool exec_CONST(runtime_t *runtime, instruction_t instr, thread_t *thread
     if (string_id >= runtime->code->data_descriptor_count) {
         return false; // bad bytecode
     }
-    object_t *key = load_string(runtime, thread->process, string_id);
     object_t *value = pop_object_from_stack(thread->data_stack);
     if (value == NULL) {
         return false; // empty stack
     }
+    if (thread->context->frame) {
+        if (!declare_local_variable(thread->context, instr.arg0, value)) {
+            return false; // already exists
+        }
+        thread->instr_id++;
+        return true;
+    }
+    object_t *key = load_string(runtime, thread->process, string_id);
     model_status_t result = create_object_property(thread->context->data, key, value, true);
     if (result != MSTAT_OK) {
         return false; // already exists
@@ -482,6 +874,7 @@ static bool exec_CONST(runtime_t *runtime, instruction_t instr, thread_t *thread
  * 1. Current context's variables
  * 2. Prototype chain (parent contexts)
  * If the variable is not found, it creates a new mutable variable in current context.
+ * The search through the prototype chain is memoized in the inline cache of the instruction.
  * The operation will fail if:
  * - The string_id is invalid
  * - The stack is empty
@@ -502,30 +895,12 @@ static bool exec_STORE(runtime_t *runtime, instruction_t instr, thread_t *thread
         return false; // empty stack
     }
     object_t *context = thread->context->data;
-    bool changed = false;
-    model_status_t result = set_object_property(context, key, value);
-    assert(result != MSTAT_IMMUTABLE_OBJECT);
-    if (result == MSTAT_OK) {
-        changed = true;
-    }
-    else if (result == MSTAT_PROPERTY_NOT_FOUND) {
-        object_array_t proto = get_object_topology(context);
-        size_t index = 0;
-        do {
-            result = set_object_property(proto.items[index], key, value);
-            if (result == MSTAT_IMMUTABLE_OBJECT) {
-                break;
-            }
-            if (result == MSTAT_OK) {
-                changed = true;
-                break;
-            }
-            index++;
-        } while (index < proto.size);
-    }
-    if (!changed) {
-        result = create_object_property(context, key, value, false);
-        if (result != MSTAT_OK) {
+    size_t index;
+    object_t *holder = lookup_with_cache(&runtime->caches[thread->instr_id], context,
+        key, &index);
+    if (holder == NULL || index == SIZE_MAX ||
+            set_object_property_by_index(holder, index, key, value) != MSTAT_OK) {
+        if (!store_variable(context, key, value)) {
             return false;
         }
     }
@@ -534,54 +909,189 @@ static bool exec_STORE(runtime_t *runtime, instruction_t instr, thread_t *thread
 }
 
 /**
- * @brief Executes the `ADD` instruction.
- * 
- * The `ADD` opcode performs an addition operation on the top two objects on the data stack.
- * It pops the top two objects from the stack, adds them using their respective `add` methods,
- * and pushes the result back onto the stack. If either of the objects cannot be added, the
- * operation fails.
- * 
+ * @brief Executes the LLOAD opcode to load a local variable addressed by its slot.
+ *
+ * The variable is taken directly from the slot `arg0` of the context that is `flags` levels
+ * up the chain, provided that the slot holds a variable named `arg1` (for a frame, that
+ * the variable has been declared). Otherwise the variable is searched for by name,
+ * as `VLOAD` does.
+ *
  * @param runtime The runtime environment.
  * @param instr The instruction to execute.
  * @param thread Pointer to the thread that is executing the instruction.
- * @return Returns `true` if the addition was successful and the result was pushed onto the stack,
- *  or `false` if the addition failed (e.g., due to invalid object types).
+ * @return `true` if the variable value was successfully loaded and pushed onto the stack,
+ *  `false` if there is an error (e.g., invalid string id or bytecode corruption).
  */
-static bool exec_ADD(runtime_t *runtime, instruction_t instr, thread_t *thread) {
-    object_t *second = pop_object_from_stack(thread->data_stack);
-    object_t *first = pop_object_from_stack(thread->data_stack);
-    if (first && second) {
-        object_t *result = add_objects(thread->process, first, second);
-        if (result) {
-            DECREF(first);
-            DECREF(second);
-            push_object_onto_stack(thread->data_stack, result);
-            thread->instr_id++;
-            return true;
-        }
+static bool exec_LLOAD(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    uint32_t string_id = instr.arg1;
+    if (string_id >= runtime->code->data_descriptor_count) {
+        return false; // bad bytecode
     }
-    return false;
+    object_t *key = load_string(runtime, thread->process, string_id);
+    object_t *context = thread->context->data;
+    object_t *holder;
+    object_t **local = resolve_local_variable(thread->context, instr.flags, instr.arg0, &holder);
+    object_t *value = local ? *local
+        : holder ? get_object_property_by_index(holder, instr.arg0, key) : NULL;
+    if (value == NULL) {
+        value = get_property_from_object_or_its_prototypes(context, key);
+    }
+    push_object_onto_stack(thread->data_stack, value);
+    INCREF(value);
+    thread->instr_id++;
+    return true;
 }
 
 /**
- * @brief Executes the `SUB` instruction.
- * 
- * The `SUB` opcode performs a subtraction operation on the top two objects on the data stack.
- * It pops the top two objects from the stack, subtracts the second operand from the first using
- * their respective `sub` methods, and pushes the result back onto the stack. If either of the
- * objects cannot be subtracted, the operation fails.
- * 
+ * @brief Executes the LSTORE opcode to update a local variable addressed by its slot.
+ *
+ * The value is written directly to the slot `arg0` of the context that is `flags` levels
+ * up the chain, provided that the slot holds a mutable variable named `arg1` (for a frame,
+ * the slot is always written). Otherwise the value is stored by name, as `STORE` does.
+ *
  * @param runtime The runtime environment.
- * @param instr The instruction to execute.
- * @param thread Pointer to the thread that is executing the instruction.
- * @return Returns `true` if the subtraction was successful and the result was pushed onto the
- *  stack, or `false` if the subtraction failed (e.g., due to invalid object types).
+ * @param instr The instruction containing the slot address and the string_id argument.
+ * @param thread The thread executing the instruction.
+ * @return `true` if the value was successfully stored, `false` on any error.
  */
-static bool exec_SUB(runtime_t *runtime, instruction_t instr, thread_t *thread) {
-    object_t *second = pop_object_from_stack(thread->data_stack);
-    object_t *first = pop_object_from_stack(thread->data_stack);
-    if (first && second) {
-        object_t *result = subtract_objects(thread->process, first, second);
+static bool exec_LSTORE(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    uint32_t string_id = instr.arg1;
+    if (string_id >= runtime->code->data_descriptor_count) {
+        return false; // bad bytecode
+    }
+    object_t *key = load_string(runtime, thread->process, string_id);
+    object_t *value = peek_object_from_stack(thread->data_stack, 0);
+    if (value == NULL) {
+        return false; // empty stack
+    }
+    object_t *context = thread->context->data;
+    object_t *holder;
+    object_t **local = resolve_local_variable(thread->context, instr.flags, instr.arg0, &holder);
+    if (local != NULL) {
+        INCREF(value);
+        DECREFIF(*local);
+        *local = value;
+    } else if (holder == NULL ||
+            set_object_property_by_index(holder, instr.arg0, key, value) != MSTAT_OK) {
+        if (!store_variable(context, key, value)) {
+            return false;
+        }
+    }
+    thread->instr_id++;
+    return true;
+}
+
+/**
+ * @brief Quickens a generic arithmetic or comparison instruction.
+ * 
+ * If the operands on top of the data stack are two tagged integers, or a real number and
+ * a number, the instruction is rewritten in the private copy of the instructions into its
+ * specialized form, marked with `INSTRUCTION_QUICKENED`. The current execution still goes
+ * through the generic path; the next ones take the fast path while the guard of the
+ * specialized instruction holds. A deoptimized instruction is never quickened again.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction being executed.
+ * @param thread The thread executing the instruction.
+ * @param generic The generic opcode; other instructions (specialized ones falling back to
+ *  the generic path) are not rewritten.
+ * @param integer The specialized opcode for integer operands.
+ * @param real The specialized opcode for real operands, or `NOP` if there is none.
+ */
+static inline void quicken_instruction(runtime_t *runtime, instruction_t instr, thread_t *thread,
+        opcode_t generic, opcode_t integer, opcode_t real) {
+    const object_stack_t *stack = thread->data_stack;
+    if (instr.opcode != generic || (instr.flags & INSTRUCTION_DEOPTIMIZED) || stack->size < 2) {
+        return;
+    }
+    const object_t *left = stack->objects[stack->size - 2];
+    const object_t *right = stack->objects[stack->size - 1];
+    opcode_t opcode;
+    if (is_tagged_integer(left) && is_tagged_integer(right)) {
+        opcode = integer;
+    } else if (real != NOP && is_real_number(left)
+            && (is_tagged_integer(right) || is_real_number(right))) {
+        opcode = real;
+    } else {
+        return;
+    }
+    instr.opcode = opcode;
+    instr.flags = INSTRUCTION_QUICKENED;
+    runtime->instructions[thread->instr_id] = instr;
+}
+
+/**
+ * @brief Turns a quickened instruction whose guard has failed back into the generic one.
+ * 
+ * The generic instruction is marked with `INSTRUCTION_DEOPTIMIZED`, so operands of
+ * changing types do not make it flip back and forth. Specialized instructions emitted
+ * by the compiler are left as they are.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction being executed.
+ * @param thread The thread executing the instruction.
+ * @param generic The generic opcode.
+ */
+static inline void deoptimize_instruction(runtime_t *runtime, instruction_t instr,
+        thread_t *thread, opcode_t generic) {
+    if (instr.flags & INSTRUCTION_QUICKENED) {
+        instr.opcode = generic;
+        instr.flags = INSTRUCTION_DEOPTIMIZED;
+        runtime->instructions[thread->instr_id] = instr;
+    }
+}
+
+/**
+ * @brief Executes the `ADD` instruction.
+ * 
+ * The `ADD` opcode performs an addition operation on the top two objects on the data stack.
+ * It pops the top two objects from the stack, adds them using their respective `add` methods,
+ * and pushes the result back onto the stack. If either of the objects cannot be added, the
+ * operation fails. Numeric operands quicken the instruction into `IADD` or `RADD`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return Returns `true` if the addition was successful and the result was pushed onto the stack,
+ *  or `false` if the addition failed (e.g., due to invalid object types).
+ */
+static bool exec_ADD(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    quicken_instruction(runtime, instr, thread, ADD, IADD, RADD);
+    object_t *second = pop_object_from_stack(thread->data_stack);
+    object_t *first = pop_object_from_stack(thread->data_stack);
+    if (first && second) {
+        object_t *result = add_objects(thread->process, first, second);
+        if (result) {
+            DECREF(first);
+            DECREF(second);
+            push_object_onto_stack(thread->data_stack, result);
+            thread->instr_id++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Executes the `SUB` instruction.
+ * 
+ * The `SUB` opcode performs a subtraction operation on the top two objects on the data stack.
+ * It pops the top two objects from the stack, subtracts the second operand from the first using
+ * their respective `sub` methods, and pushes the result back onto the stack. If either of the
+ * objects cannot be subtracted, the operation fails.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return Returns `true` if the subtraction was successful and the result was pushed onto the
+ *  stack, or `false` if the subtraction failed (e.g., due to invalid object types).
+ */
+static bool exec_SUB(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    quicken_instruction(runtime, instr, thread, SUB, ISUB, RSUB);
+    object_t *second = pop_object_from_stack(thread->data_stack);
+    object_t *first = pop_object_from_stack(thread->data_stack);
+    if (first && second) {
+        object_t *result = subtract_objects(thread->process, first, second);
         if (result) {
             DECREF(first);
             DECREF(second);
@@ -605,6 +1115,7 @@ static bool exec_SUB(runtime_t *runtime, instruction_t instr, thread_t *thread)
  * @return `true` if multiplication succeeded, `false` otherwise.
  */
 static bool exec_MUL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    quicken_instruction(runtime, instr, thread, MUL, IMUL, RMUL);
     object_t *second = pop_object_from_stack(thread->data_stack);
     object_t *first = pop_object_from_stack(thread->data_stack);
     if (first && second) {
@@ -712,6 +1223,7 @@ static bool exec_POWER(runtime_t *runtime, instruction_t instr, thread_t *thread
  * @return `true` if comparison succeeded, `false` otherwise.
  */
 static bool exec_LESS(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    quicken_instruction(runtime, instr, thread, LESS, ILESS, RLESS);
     object_t *second = pop_object_from_stack(thread->data_stack);
     object_t *first = pop_object_from_stack(thread->data_stack);
     if (first && second) {
@@ -809,6 +1321,7 @@ static bool exec_GREQ(runtime_t *runtime, instruction_t instr, thread_t *thread)
  * @return `true` if comparison succeeded, `false` otherwise.
  */
 static bool exec_EQUAL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    quicken_instruction(runtime, instr, thread, EQUAL, IEQUAL, NOP);
     object_t *second = pop_object_from_stack(thread->data_stack);
     object_t *first = pop_object_from_stack(thread->data_stack);
     if (first && second) {
@@ -846,6 +1359,437 @@ static bool exec_DIFF(runtime_t *runtime, instruction_t instr, thread_t *thread)
     return false;
 }
 
+/**
+ * @brief Reads the operands of an integer instruction if both of them are tagged integers.
+ * 
+ * The operands are left on the data stack: tagged integers are not reference counted, so
+ * the caller simply overwrites them with the result.
+ * 
+ * @param stack The data stack.
+ * @param first Where to store the value of the first (deeper) operand.
+ * @param second Where to store the value of the second (topmost) operand.
+ * @return `true` if both operands are tagged integers, `false` otherwise.
+ */
+static inline bool peek_integer_operands(const object_stack_t *stack, int64_t *first,
+        int64_t *second) {
+    if (stack->size < 2) {
+        return false;
+    }
+    const object_t *left = stack->objects[stack->size - 2];
+    const object_t *right = stack->objects[stack->size - 1];
+    if (!is_tagged_integer(left) || !is_tagged_integer(right)) {
+        return false;
+    }
+    *first = get_tagged_integer_value(left);
+    *second = get_tagged_integer_value(right);
+    return true;
+}
+
+/**
+ * @brief Reads the operands of a real instruction if the first one is a real number and
+ *  the second one is a real number or a tagged integer.
+ * 
+ * This is exactly the case when the generic operation would be performed by the real number
+ * on the left on `double` values.
+ * 
+ * @param stack The data stack.
+ * @param first Where to store the value of the first (deeper) operand.
+ * @param second Where to store the value of the second (topmost) operand.
+ * @return `true` if the operands are numbers of suitable types, `false` otherwise.
+ */
+static inline bool peek_real_operands(const object_stack_t *stack, double *first,
+        double *second) {
+    if (stack->size < 2) {
+        return false;
+    }
+    const object_t *left = stack->objects[stack->size - 2];
+    const object_t *right = stack->objects[stack->size - 1];
+    if (!is_real_number(left) || !(is_tagged_integer(right) || is_real_number(right))) {
+        return false;
+    }
+    *first = get_object_real_value(left).value;
+    *second = get_object_real_value(right).value;
+    return true;
+}
+
+/**
+ * @brief Replaces the two operands on top of the data stack with the result.
+ * @param thread The thread executing the instruction.
+ * @param result The result, its reference is passed to the stack.
+ */
+static inline void replace_operands(thread_t *thread, object_t *result) {
+    object_stack_t *stack = thread->data_stack;
+    object_t *second = stack->objects[--stack->size];
+    object_t *first = stack->objects[stack->size - 1];
+    stack->objects[stack->size - 1] = result;
+    DECREF(first);
+    DECREF(second);
+    thread->instr_id++;
+}
+
+/**
+ * @brief Creates the result of an integer instruction.
+ * @param thread The thread executing the instruction.
+ * @param instr The instruction; the `INTEGER_RESULT_FITS` flag means that the value is known
+ *  to fit into a tagged integer.
+ * @param value The value of the result.
+ * @return The result object.
+ */
+static inline object_t *make_integer_result(thread_t *thread, instruction_t instr,
+        int64_t value) {
+    return instr.flags & INTEGER_RESULT_FITS ? make_tagged_integer(value)
+        : create_integer_object(thread->process, value);
+}
+
+/**
+ * @brief Executes the `IADD` instruction.
+ * 
+ * Adds two tagged integers directly; for any other operands, behaves exactly like `ADD`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if addition succeeded, `false` otherwise.
+ */
+static bool exec_IADD(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    int64_t first, second;
+    if (peek_integer_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, make_integer_result(thread, instr, first + second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, ADD);
+    return exec_ADD(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `ISUB` instruction.
+ * 
+ * Subtracts two tagged integers directly; for any other operands, behaves exactly like `SUB`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if subtraction succeeded, `false` otherwise.
+ */
+static bool exec_ISUB(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    int64_t first, second;
+    if (peek_integer_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, make_integer_result(thread, instr, first - second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, SUB);
+    return exec_SUB(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `IMUL` instruction.
+ * 
+ * Multiplies two tagged integers directly; for any other operands, behaves exactly like `MUL`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if multiplication succeeded, `false` otherwise.
+ */
+static bool exec_IMUL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    int64_t first, second;
+    if (peek_integer_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, make_integer_result(thread, instr, first * second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, MUL);
+    return exec_MUL(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `ILESS` instruction.
+ * 
+ * Compares two tagged integers directly; for any other operands, behaves exactly like `LESS`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if comparison succeeded, `false` otherwise.
+ */
+static bool exec_ILESS(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    int64_t first, second;
+    if (peek_integer_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, get_boolean_object(first < second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, LESS);
+    return exec_LESS(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `IEQUAL` instruction.
+ * 
+ * Two tagged integers are equal if and only if their tagged representations are equal;
+ * for any other operands, behaves exactly like `EQUAL`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if comparison succeeded, `false` otherwise.
+ */
+static bool exec_IEQUAL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    int64_t first, second;
+    if (peek_integer_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, get_boolean_object(first == second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, EQUAL);
+    return exec_EQUAL(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `RADD` instruction.
+ * 
+ * Adds a real number and a number directly; for any other operands, behaves exactly like `ADD`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if addition succeeded, `false` otherwise.
+ */
+static bool exec_RADD(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    double first, second;
+    if (peek_real_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, create_real_number_object(thread->process, first + second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, ADD);
+    return exec_ADD(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `RSUB` instruction.
+ * 
+ * Subtracts a number from a real number directly; for any other operands, behaves exactly
+ * like `SUB`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if subtraction succeeded, `false` otherwise.
+ */
+static bool exec_RSUB(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    double first, second;
+    if (peek_real_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, create_real_number_object(thread->process, first - second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, SUB);
+    return exec_SUB(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `RMUL` instruction.
+ * 
+ * Multiplies a real number by a number directly; for any other operands, behaves exactly
+ * like `MUL`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if multiplication succeeded, `false` otherwise.
+ */
+static bool exec_RMUL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    double first, second;
+    if (peek_real_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, create_real_number_object(thread->process, first * second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, MUL);
+    return exec_MUL(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `RLESS` instruction.
+ * 
+ * Compares a real number with a number directly; for any other operands, behaves exactly
+ * like `LESS`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if comparison succeeded, `false` otherwise.
+ */
+static bool exec_RLESS(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    double first, second;
+    if (peek_real_operands(thread->data_stack, &first, &second)) {
+        replace_operands(thread, get_boolean_object(first < second));
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, LESS);
+    return exec_LESS(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `JNLT` instruction.
+ * 
+ * Pops the top two objects from the data stack and compares them like `LESS` does. If the first
+ * one is not less than the second, jumps to the instruction `arg1`; otherwise goes on to the
+ * next instruction. Integer operands quicken the instruction into `IJNLT`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if comparison succeeded, `false` otherwise.
+ */
+static bool exec_JNLT(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    quicken_instruction(runtime, instr, thread, JNLT, IJNLT, NOP);
+    object_t *second = pop_object_from_stack(thread->data_stack);
+    object_t *first = pop_object_from_stack(thread->data_stack);
+    if (first && second) {
+        bool result = is_object_less_than(first, second);
+        DECREF(first);
+        DECREF(second);
+        if (result) {
+            thread->instr_id++;
+        } else {
+            thread->instr_id = (instr_index_t)instr.arg1;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Executes the `IJNLT` instruction.
+ * 
+ * Compares two tagged integers directly and jumps if the first one is not less than
+ * the second; for any other operands, behaves exactly like `JNLT`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if comparison succeeded, `false` otherwise.
+ */
+static bool exec_IJNLT(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    int64_t first, second;
+    if (peek_integer_operands(thread->data_stack, &first, &second)) {
+        thread->data_stack->size -= 2;
+        if (first < second) {
+            thread->instr_id++;
+        } else {
+            thread->instr_id = (instr_index_t)instr.arg1;
+        }
+        return true;
+    }
+    deoptimize_instruction(runtime, instr, thread, JNLT);
+    return exec_JNLT(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `ADDI` instruction.
+ * 
+ * Adds the constant `arg1` to a tagged integer on top of the data stack directly;
+ * for any other object, pushes the constant and behaves exactly like `ADD`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if addition succeeded, `false` otherwise.
+ */
+static bool exec_ADDI(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    object_stack_t *stack = thread->data_stack;
+    int64_t value = (int32_t)instr.arg1;
+    if (stack->size > 0 && is_tagged_integer(stack->objects[stack->size - 1])) {
+        int64_t sum = get_tagged_integer_value(stack->objects[stack->size - 1]) + value;
+        stack->objects[stack->size - 1] = make_integer_result(thread, instr, sum);
+        thread->instr_id++;
+        return true;
+    }
+    push_object_onto_stack(stack, make_tagged_integer(value));
+    return exec_ADD(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `SUBI` instruction.
+ * 
+ * Subtracts the constant `arg1` from a tagged integer on top of the data stack directly;
+ * for any other object, pushes the constant and behaves exactly like `SUB`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if subtraction succeeded, `false` otherwise.
+ */
+static bool exec_SUBI(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    object_stack_t *stack = thread->data_stack;
+    int64_t value = (int32_t)instr.arg1;
+    if (stack->size > 0 && is_tagged_integer(stack->objects[stack->size - 1])) {
+        int64_t difference = get_tagged_integer_value(stack->objects[stack->size - 1]) - value;
+        stack->objects[stack->size - 1] = make_integer_result(thread, instr, difference);
+        thread->instr_id++;
+        return true;
+    }
+    push_object_onto_stack(stack, make_tagged_integer(value));
+    return exec_SUB(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `JNLTI` instruction.
+ * 
+ * Compares a tagged integer on top of the data stack with the constant `arg0` directly;
+ * for any other object, pushes the constant and behaves exactly like `JNLT`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if comparison succeeded, `false` otherwise.
+ */
+static bool exec_JNLTI(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    object_stack_t *stack = thread->data_stack;
+    int64_t value = (int16_t)instr.arg0;
+    if (stack->size > 0 && is_tagged_integer(stack->objects[stack->size - 1])) {
+        bool result = get_tagged_integer_value(stack->objects[--stack->size]) < value;
+        if (result) {
+            thread->instr_id++;
+        } else {
+            thread->instr_id = (instr_index_t)instr.arg1;
+        }
+        return true;
+    }
+    push_object_onto_stack(stack, make_tagged_integer(value));
+    return exec_JNLT(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `VARNIL` instruction.
+ * 
+ * Declares a variable initialized with `null`, exactly like `NIL` followed by `VAR`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if the variable was successfully declared, `false` on any error.
+ */
+static bool exec_VARNIL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    push_object_onto_stack(thread->data_stack, get_null_object());
+    return exec_VAR(runtime, instr, thread);
+}
+
+/**
+ * @brief Executes the `LSTOREP` instruction.
+ * 
+ * Stores to a local variable like `LSTORE`, then pops the value like `POP`.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread The thread executing the instruction.
+ * @return `true` if the value was stored, `false` otherwise.
+ */
+static bool exec_LSTOREP(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (!exec_LSTORE(runtime, instr, thread)) {
+        return false;
+    }
+    object_t *value = pop_object_from_stack(thread->data_stack);
+    DECREF(value);
+    return true;
+}
+
 /**
  * @brief Executes the `FUNC` instruction.
  * 
@@ -856,14 +1800,13 @@ static bool exec_DIFF(runtime_t *runtime, instruction_t instr, thread_t *thread)
  * 
  * Execution steps:
  * - Pops the entry point address (instruction index) from the argument stack
- * - Loads argument name strings from the data segment using the descriptor at `instr.arg1`
- * - Allocates and fills an array of argument name objects
- * - Creates a function object using the entry point, argument names, and current closure
+ * - On the first execution of the instruction, loads argument name strings from the data
+ *   segment using the descriptor at `instr.arg1` and creates a function template holding
+ *   them together with the entry point (and, for a function executed in a frame, the number
+ *   of its local variable slots); later executions reuse the template
+ * - Creates a function object using the template and current closure
  * - Pushes the resulting function object onto the thread’s data stack
  * 
- * The argument name array is allocated in this function and passed to the function object,
- * which takes ownership and frees it during destruction.
- * 
  * @param runtime The runtime environment.
  * @param instr The instruction to execute: `arg0` = argument count, `arg1` = data segment index.
  * @param thread Pointer to the executing thread.
@@ -872,30 +1815,43 @@ static bool exec_DIFF(runtime_t *runtime, instruction_t instr, thread_t *thread)
  *         `false` if an error occurred (e.g., malformed bytecode or memory failure).
  */
 static bool exec_FUNC(runtime_t *runtime, instruction_t instr, thread_t *thread) {
-    object_t *closure = thread->context->data;
     if (thread->args_count < 1) {
         return false; // bad bytecode, no ARG before
     }
-    instr_index_t first_instr_id = (instr_index_t)thread->args[0];
-    uint16_t arg_count = instr.arg0;
-    object_t **arg_names = NULL;
-    if (arg_count > 0) {
-        data_descriptor_t descriptor = runtime->code->data_descriptors[instr.arg1];
-        if (arg_count * sizeof(uint32_t) != descriptor.size) {
-            return false; // bad bytecode
-        }
-        uint32_t *strings = (uint32_t*)(runtime->code->data + descriptor.offset);
-        arg_names = ALLOC(arg_count * sizeof(object_t*));
-        for (uint16_t index = 0; index < arg_count; index++) {
-            arg_names[index] = load_string(runtime, thread->process, strings[index]);
+    function_template_t *tmpl = runtime->templates[thread->instr_id];
+    if (tmpl == NULL) {
+        uint16_t arg_count = instr.arg0;
+        bool frame = (instr.flags & FUNCTION_IN_FRAME) != 0;
+        size_t word_count = frame ? arg_count + 1 : arg_count;
+        object_t **arg_names = NULL;
+        size_t local_count = 0;
+        if (word_count > 0) {
+            data_descriptor_t descriptor = runtime->code->data_descriptors[instr.arg1];
+            if (word_count * sizeof(uint32_t) != descriptor.size) {
+                return false; // bad bytecode
+            }
+            uint32_t *words = (uint32_t*)(runtime->code->data + descriptor.offset);
+            if (frame) {
+                local_count = words[arg_count];
+                if (local_count < arg_count) {
+                    return false; // bad bytecode
+                }
+            }
+            if (arg_count > 0) {
+                arg_names = ALLOC(arg_count * sizeof(object_t*));
+                for (uint16_t index = 0; index < arg_count; index++) {
+                    arg_names[index] = load_string(runtime, thread->process, words[index]);
+                }
+            }
         }
+        tmpl = create_function_template(thread->process, arg_names, arg_count,
+            (instr_index_t)thread->args[0], thread->instr_id, frame, local_count);
+        runtime->templates[thread->instr_id] = tmpl;
     }
     object_t *function = create_function_object(
         thread->process,
-        arg_names,
-        arg_count,
-        first_instr_id,
-        closure
+        tmpl,
+        thread->context->data
     );
     push_object_onto_stack(thread->data_stack, function);
     thread->args_count = 0;
@@ -922,6 +1878,10 @@ static bool exec_FUNC(runtime_t *runtime, instruction_t instr, thread_t *thread)
  * are on the stack, or other runtime errors occur), the operation fails, and the instruction
  * is not marked as successfully executed.
  * 
+ * Calls are the safe points of the garbage collector: before the function is popped, every
+ * object in use is on a data stack or in a context. As the language has no loops, a program
+ * can not run for long without passing through calls.
+ * 
  * @param runtime The runtime environment.
  * @param instr The instruction to execute. The `arg0` field specifies the number of arguments
  *  to pass to the function.
@@ -930,6 +1890,7 @@ static bool exec_FUNC(runtime_t *runtime, instruction_t instr, thread_t *thread)
  *  the stack, or `false` if the invocation failed (e.g., invalid function object, runtime error).
  */
 static bool exec_CALL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    collect_garbage_if_needed(thread->process);
     object_t *func = pop_object_from_stack(thread->data_stack);
     bool result = call_object(func, instr.arg0, thread);
     // The ID of the following instruction was set inside the call method
@@ -937,6 +1898,55 @@ static bool exec_CALL(runtime_t *runtime, instruction_t instr, thread_t *thread)
     return result;
 }
 
+/**
+ * @brief Executes the `CALLK` instruction.
+ *
+ * Pops the function object from the data stack. If it was created by the `FUNC` instruction
+ * whose index is `arg1`, the function is entered directly using the template of that
+ * instruction; otherwise the object is called through its virtual table, as `CALL` does.
+ * Like `CALL`, it is a safe point of the garbage collector.
+ *
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute: `arg0` = argument count, `arg1` = index of
+ *  the `FUNC` instruction.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the function was successfully invoked, `false` otherwise.
+ */
+static bool exec_CALLK(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (instr.arg1 >= runtime->code->instructions_count
+            || runtime->code->instructions[instr.arg1].opcode != FUNC) {
+        return false; // bad bytecode
+    }
+    collect_garbage_if_needed(thread->process);
+    object_t *func = pop_object_from_stack(thread->data_stack);
+    bool result = call_function_with_template(func, runtime->templates[instr.arg1],
+        instr.arg0, thread);
+    DECREF(func);
+    return result;
+}
+
+/**
+ * @brief Executes the `TAILCALL` instruction.
+ *
+ * Pops the function object from the data stack and calls it in tail position. A user-defined
+ * function called from the frame of another function reuses that frame; in any other case,
+ * the call is an ordinary one and the following `RET` instruction returns its result.
+ * Like `CALL`, it is a safe point of the garbage collector.
+ *
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute. The `arg0` field specifies the number of arguments
+ *  to pass to the function.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the function was successfully invoked, `false` otherwise.
+ */
+static bool exec_TAILCALL(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    collect_garbage_if_needed(thread->process);
+    object_t *func = pop_object_from_stack(thread->data_stack);
+    bool result = tail_call_object(func, instr.arg0, thread);
+    DECREF(func);
+    return result;
+}
+
 /**
  * @brief Executes the `RET` instruction.
  * 
@@ -966,6 +1976,7 @@ static bool exec_RET(runtime_t *runtime, instruction_t instr, thread_t *thread)
         return false; // stack is empty
     }
     replace_object_on_stack(thread->data_stack, ret_value, ctx->ret_value_index);
+    DECREF(ret_value);
     reduce_object_stack(thread->data_stack, ctx->unwinding_index);
     thread->instr_id = ctx->ret_address;
     thread->context = destroy_context(ctx);
@@ -1021,6 +2032,145 @@ static bool exec_LEAVE(runtime_t *runtime, instruction_t instr, thread_t *thread
     return true;
 }
 
+/**
+ * @brief Executes the `ENTERF` instruction.
+ * 
+ * Creates a frame with `arg1` empty local variable slots for a block whose environment can
+ * not escape. Name lookups from the frame go to the environment of the current context.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return Always returns `true`.
+ */
+static bool exec_ENTERF(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    context_t *ctx = thread->context;
+    thread->context = create_frame(ctx, ctx->data, instr.arg1);
+    thread->instr_id++;
+    return true;
+}
+
+/**
+ * @brief Executes the `LEAVEF` instruction.
+ * 
+ * Destroys the current frame together with its local variables, restores the previous
+ * context and pushes `null` as the value of the block.
+ * 
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return Always returns `true`.
+ */
+static bool exec_LEAVEF(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    thread->context = destroy_context(thread->context);
+    push_object_onto_stack(thread->data_stack, get_null_object());
+    thread->instr_id++;
+    return true;
+}
+
+/**
+ * @brief Replaces the object on top of the data stack with the result of an intrinsic.
+ * @param thread The thread executing the instruction.
+ * @param result The result, its reference is passed to the stack.
+ */
+static inline void replace_operand(thread_t *thread, object_t *result) {
+    object_stack_t *stack = thread->data_stack;
+    object_t *operand = stack->objects[stack->size - 1];
+    stack->objects[stack->size - 1] = result;
+    DECREF(operand);
+    thread->instr_id++;
+}
+
+/**
+ * @brief Executes the `PRINT` instruction.
+ *
+ * Prints the string representation of the object on top of the data stack and replaces
+ * the object with `null`, as a call of the built-in `print` function does.
+ *
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the object was printed, `false` if the stack is empty.
+ */
+static bool exec_PRINT(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (thread->data_stack->size < 1) {
+        return false;
+    }
+    string_value_t str = convert_object_to_string(peek_object_from_stack(thread->data_stack, 0));
+    if (str.data) {
+        print_utf8(str.data);
+        FREE_STRING(str);
+    }
+    replace_operand(thread, get_null_object());
+    return true;
+}
+
+/**
+ * @brief Executes the `SQRT` instruction.
+ *
+ * Replaces the number on top of the data stack with its square root, as a call of
+ * the built-in `sqrt` function does.
+ *
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the root was computed, `false` if the stack is empty.
+ */
+static bool exec_SQRT(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (thread->data_stack->size < 1) {
+        return false;
+    }
+    double value = get_object_real_value(peek_object_from_stack(thread->data_stack, 0)).value;
+    replace_operand(thread, create_real_number_object(thread->process, sqrt(value)));
+    return true;
+}
+
+/**
+ * @brief Executes the `SIGN` instruction.
+ *
+ * Replaces the number on top of the data stack with -1, 0 or 1, as a call of the built-in
+ * `sign` function does.
+ *
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the sign was computed, `false` if the stack is empty.
+ */
+static bool exec_SIGN(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (thread->data_stack->size < 1) {
+        return false;
+    }
+    double value = get_object_real_value(peek_object_from_stack(thread->data_stack, 0)).value;
+    replace_operand(thread, make_tagged_integer(value > 0 ? 1 : (value < 0 ? -1 : 0)));
+    return true;
+}
+
+/**
+ * @brief Executes the `ATAN2` instruction.
+ *
+ * Replaces the Y coordinate on top of the data stack and the X coordinate below it with
+ * the arc tangent of Y / X, as a call of the built-in `atan` function does; if any of them
+ * is not a number, the result is `null`.
+ *
+ * @param runtime The runtime environment.
+ * @param instr The instruction to execute.
+ * @param thread Pointer to the thread that is executing the instruction.
+ * @return `true` if the instruction was executed, `false` if the stack has less than
+ *  two objects.
+ */
+static bool exec_ATAN2(runtime_t *runtime, instruction_t instr, thread_t *thread) {
+    if (thread->data_stack->size < 2) {
+        return false;
+    }
+    real_value_t y = get_object_real_value(peek_object_from_stack(thread->data_stack, 0));
+    real_value_t x = get_object_real_value(peek_object_from_stack(thread->data_stack, 1));
+    object_t *result = x.has_value && y.has_value
+        ? create_real_number_object(thread->process, atan2(y.value, x.value))
+        : get_null_object();
+    replace_operands(thread, result);
+    return true;
+}
+
 /**
  * @brief Array of instruction execution functions for the Goat virtual machine.
  * 
@@ -1045,10 +2195,14 @@ static instr_executor_t executors[] = {
     exec_ILOAD64, /**< Pushes a 64-bit integer onto the data stack. */
     exec_RLOAD,   /**< Pushes a 64-bit float onto the data stack. */
     exec_SLOAD,   /**< Pushes a static string onto the data stack. */
+    exec_ILOADK,  /**< Pushes an integer constant from the data segment. */
+    exec_RLOADK,  /**< Pushes a real number constant from the data segment. */
     exec_VLOAD,   /**< Loads a variable value onto the data stack or `null` if undefined. */
     exec_VAR,     /**< Declares a new mutable variable in current context. */
     exec_CONST,   /**< Declares a new immutable constant in current context. */
     exec_STORE,   /**< Stores to existing variable or creates new if not found. */
+    exec_LLOAD,   /**< Loads a local variable by (depth, slot). */
+    exec_LSTORE,  /**< Stores to a local variable by (depth, slot). */
     exec_ADD,     /**< Adds the top two objects of the stack. */
     exec_SUB,     /**< Subtracts the top two objects of the stack. */
     exec_MUL,     /**< Multiplies the top two objects on the data stack. */
@@ -1061,40 +2215,202 @@ static instr_executor_t executors[] = {
     exec_GREQ,    /**< Checks if first >= second and pushes boolean result. */
     exec_EQUAL,   /**< Pushes `true` if top two objects are equal. */
     exec_DIFF,    /**< Pushes `true` if top two objects are not equal. */
+    exec_IADD,    /**< Adds two integers, or falls back to `ADD`. */
+    exec_ISUB,    /**< Subtracts two integers, or falls back to `SUB`. */
+    exec_IMUL,    /**< Multiplies two integers, or falls back to `MUL`. */
+    exec_ILESS,   /**< Compares two integers, or falls back to `LESS`. */
+    exec_IEQUAL,  /**< Checks two integers for equality, or falls back to `EQUAL`. */
+    exec_RADD,    /**< Adds two real numbers, or falls back to `ADD`. */
+    exec_RSUB,    /**< Subtracts two real numbers, or falls back to `SUB`. */
+    exec_RMUL,    /**< Multiplies two real numbers, or falls back to `MUL`. */
+    exec_RLESS,   /**< Compares two real numbers, or falls back to `LESS`. */
+    exec_JNLT,    /**< Compares two objects, jumps if the first is not less. */
+    exec_IJNLT,   /**< Compares two integers, jumps if the first is not less. */
+    exec_ADDI,    /**< Adds an integer constant to the top of the stack. */
+    exec_SUBI,    /**< Subtracts an integer constant from the top of the stack. */
+    exec_JNLTI,   /**< Compares the top of the stack with a constant, jumps if it is not less. */
+    exec_VARNIL,  /**< Declares a variable initialized with `null`. */
+    exec_LSTOREP, /**< Stores to a local variable, then pops the value off the data stack. */
     exec_FUNC,    /**< Creates a new function object. */
     exec_CALL,    /**< Calls a function with arguments from the data stack. */
+    exec_CALLK,   /**< Calls a function created by a known FUNC instruction. */
+    exec_TAILCALL, /**< Calls a function, reusing the current frame. */
     exec_RET,     /**< Returns from current function. */
     exec_ENTER,   /**< Creates a new context, inheriting from the current one. */
-    exec_LEAVE    /**< Restores the parent context, leaving the current one on the stack. */
+    exec_LEAVE,   /**< Restores the parent context, leaving the current one on the stack. */
+    exec_ENTERF,  /**< Creates a new frame for a block. */
+    exec_LEAVEF,  /**< Destroys the current frame, pushes `null`. */
+    exec_PRINT,   /**< Prints the top object, replaces it with `null`. */
+    exec_SQRT,    /**< Replaces the top number with its square root. */
+    exec_SIGN,    /**< Replaces the top number with its sign. */
+    exec_ATAN2    /**< Replaces two numbers (y on top, x below) with their arc tangent. */
     // Additional opcodes can be added here in the future...
 };
 
+#ifdef THREADED_DISPATCH
+/**
+ * @def LABEL_ADDRESS
+ * @brief Produces an entry of the label table of the threaded dispatch engine.
+ */
+#define LABEL_ADDRESS(name, reference) &&op_##name,
+
+/**
+ * @def DISPATCH
+ * @brief Fetches the current instruction of the thread and jumps to its handler.
+ */
+#define DISPATCH() \
+    do { \
+        instr = instructions[thread->instr_id]; \
+        goto *labels[instr.opcode]; \
+    } while (false)
+
+/**
+ * @brief Runs a single thread until the program halts, using direct threading (computed goto).
+ * 
+ * Instead of calling executors through the `executors` table and returning to a central loop,
+ * every opcode has its own label, and the end of each handler jumps straight to the handler
+ * of the next instruction through a table of label addresses. Executors are called directly,
+ * so the compiler can inline them, and each opcode gets its own indirect branch, which the CPU
+ * predicts much better than a single shared one. The instruction array is kept in a local
+ * variable for the whole run.
+ * 
+ * This is the fast path for the (currently only) case where the process has a single thread:
+ * there is no scheduling at all, so nothing but the dispatch is done between instructions.
+ * 
+ * @param runtime The runtime environment.
+ * @param thread The thread to execute.
+ */
+static void run_single_thread(runtime_t *runtime, thread_t *thread) {
+    static void *labels[] = { FOR_EACH_OPCODE(LABEL_ADDRESS) };
+    static_assert(sizeof(labels) / sizeof(labels[0]) == sizeof(executors) / sizeof(executors[0]),
+        "The label table does not match the executor table");
+    const instruction_t *instructions = runtime->instructions;
+    instruction_t instr;
+
+    #define HANDLER(name, reference) \
+        op_##name: \
+            if (!exec_##name(runtime, instr, thread)) { \
+                return; \
+            } \
+            DISPATCH();
+
+    DISPATCH();
+    FOR_EACH_OPCODE(HANDLER)
+    #undef HANDLER
+}
+
+/**
+ * @brief Runs one time slice of a thread using direct threading (computed goto).
+ * 
+ * Works like `run_single_thread()`, but executes at most `quantum` instructions, after which
+ * the thread yields so that the scheduler can pass control to the next thread.
+ * 
+ * @param runtime The runtime environment.
+ * @param thread The thread to execute.
+ * @param quantum The maximum number of instructions to execute, must be greater than zero.
+ * @return `true` if the time slice has expired and the execution should go on,
+ *  `false` if the program halted.
+ */
+static bool run_time_slice(runtime_t *runtime, thread_t *thread, uint32_t quantum) {
+    static void *labels[] = { FOR_EACH_OPCODE(LABEL_ADDRESS) };
+    const instruction_t *instructions = runtime->instructions;
+    instruction_t instr;
+
+    #define HANDLER(name, reference) \
+        op_##name: \
+            if (!exec_##name(runtime, instr, thread)) { \
+                return false; \
+            } \
+            if (--quantum == 0) { \
+                return true; \
+            } \
+            DISPATCH();
+
+    DISPATCH();
+    FOR_EACH_OPCODE(HANDLER)
+    #undef HANDLER
+}
+
+#undef DISPATCH
+#undef LABEL_ADDRESS
+#else
+/**
+ * @brief Runs a single thread until the program halts, using the table of executors.
+ * 
+ * This is the fast path for the (currently only) case where the process has a single thread:
+ * there is no scheduling at all, so nothing but the dispatch is done between instructions.
+ * 
+ * @param runtime The runtime environment.
+ * @param thread The thread to execute.
+ */
+static void run_single_thread(runtime_t *runtime, thread_t *thread) {
+    const instruction_t *instructions = runtime->instructions;
+    instruction_t instr;
+    do {
+        instr = instructions[thread->instr_id];
+    } while (executors[instr.opcode](runtime, instr, thread));
+}
+
+/**
+ * @brief Runs one time slice of a thread using the table of executors.
+ * 
+ * Executes at most `quantum` instructions, after which the thread yields so that the scheduler
+ * can pass control to the next thread.
+ * 
+ * @param runtime The runtime environment.
+ * @param thread The thread to execute.
+ * @param quantum The maximum number of instructions to execute, must be greater than zero.
+ * @return `true` if the time slice has expired and the execution should go on,
+ *  `false` if the program halted.
+ */
+static bool run_time_slice(runtime_t *runtime, thread_t *thread, uint32_t quantum) {
+    const instruction_t *instructions = runtime->instructions;
+    do {
+        instruction_t instr = instructions[thread->instr_id];
+        if (!executors[instr.opcode](runtime, instr, thread)) {
+            return false;
+        }
+    } while (--quantum > 0);
+    return true;
+}
+#endif
+
 int run(process_t *proc, bytecode_t *code) {
 
     // preparing the environment     
     runtime_t runtime;
     runtime.code = code;
-    if ((proc->string_cache_size = code->data_descriptor_count) > 0) {
-        proc->string_cache = CALLOC(code->data_descriptor_count * sizeof(object_t*));
+    runtime.caches = CALLOC(code->instructions_count * sizeof(inline_cache_t));
+    runtime.templates = CALLOC(code->instructions_count * sizeof(function_template_t*));
+    runtime.instructions = ALLOC(code->instructions_count * sizeof(instruction_t));
+    memcpy(runtime.instructions, code->instructions,
+        code->instructions_count * sizeof(instruction_t));
+    if ((proc->constant_cache_size = code->data_descriptor_count) > 0) {
+        proc->constant_cache = CALLOC(code->data_descriptor_count * sizeof(object_t*));
     }
+    schedule_garbage_collection(proc);
 
-    // execution
-    bool flag = true;
+    // execution: each thread runs for a time slice, then yields to the next one in the ring
     thread_t *thread = proc->main_thread;
-    while (flag) {
-        instruction_t instr = code->instructions[thread->instr_id];
-        instr_executor_t exec = executors[instr.opcode];
-        flag = exec(&runtime, instr, thread);
-        thread = thread->next;
+    if (thread->next == thread) {
+        run_single_thread(&runtime, thread);
+    } else {
+        uint32_t quantum = proc->time_slice > 0 ? proc->time_slice : DEFAULT_TIME_SLICE;
+        while (run_time_slice(&runtime, thread, quantum)) {
+            thread = thread->next;
+        }
     }
 
     // cleanup
     for (size_t index = 0; index < code->data_descriptor_count; index++) {
-        DECREFIF(proc->string_cache[index]);
+        DECREFIF(proc->constant_cache[index]);
     }
-    FREE(proc->string_cache);
-    proc->string_cache = NULL;
-    proc->string_cache_size = 0;
+    FREE(proc->constant_cache);
+    FREE(runtime.caches);
+    FREE(runtime.templates);
+    FREE(runtime.instructions);
+    proc->constant_cache = NULL;
+    proc->constant_cache_size = 0;
     collect_garbage(proc);
     return 0;
 }